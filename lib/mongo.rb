@@ -17,6 +17,7 @@
 
 require 'base64'
 require 'forwardable'
+require 'io/wait'
 require 'ipaddr'
 require 'logger'
 require 'openssl'
@@ -65,6 +66,7 @@ require 'mongo/grid'
 require 'mongo/index'
 require 'mongo/lint'
 require 'mongo/query_cache'
+require 'mongo/raw_document'
 require 'mongo/server'
 require 'mongo/server_selector'
 require 'mongo/session'
@@ -20,34 +20,83 @@ module Mongo
 
     # Cache store for computed SCRAM credentials.
     #
+    # The cache is shared by all connections and clients in the process, so
+    # that the salted password and the client and server keys, whose
+    # derivation is deliberately expensive, are computed once per set of
+    # credentials, salt, iteration count and mechanism rather than once per
+    # connection.
+    #
+    # The cache is thread-safe. When several connections authenticate with
+    # the same credentials concurrently (for example when a pool is being
+    # populated after it was cleared), the value is computed by one of them
+    # while the others wait for it.
+    #
     # @api private
     module CredentialCache
 
+      @lock = Mutex.new
+
+      # Locks held while computing the value for a key, with the number of
+      # threads using each lock, by key. A lock is discarded once no thread
+      # uses it, so that threads waiting for a computation which fails
+      # compute the value one at a time, together with threads arriving
+      # later.
+      @key_locks = {}
+
+      KeyLock = Struct.new(:mutex, :users)
+
       class << self
         attr_reader :store
       end
 
       module_function def get(key)
-        @store ||= {}
-        @store[key]
+        @lock.synchronize do
+          @store ||= {}
+          @store[key]
+        end
       end
 
       module_function def set(key, value)
-        @store ||= {}
-        @store[key] = value
+        @lock.synchronize do
+          @store ||= {}
+          @store[key] = value
+        end
       end
 
       module_function def cache(key)
         value = get(key)
-        if value.nil?
-          value = yield
-          set(key, value)
+        return value unless value.nil?
+
+        key_lock = @lock.synchronize do
+          (@key_locks[key] ||= KeyLock.new(Mutex.new, 0)).tap do |lock|
+            lock.users += 1
+          end
+        end
+
+        begin
+          key_lock.mutex.synchronize do
+            # Another thread may have computed the value while this one
+            # was waiting for the lock.
+            value = get(key)
+            if value.nil?
+              value = yield
+              set(key, value)
+            end
+          end
+        ensure
+          @lock.synchronize do
+            key_lock.users -= 1
+            @key_locks.delete(key) if key_lock.users == 0
+          end
         end
+
         value
       end
 
       module_function def clear
-        @store = {}
+        @lock.synchronize do
+          @store = {}
+        end
       end
     end
   end
@@ -109,13 +109,18 @@ module Mongo
     private
 
     def start!
-      @thread = Thread.new do
+      body = lambda do
         catch(:done) do
           until @stop_requested
             do_work
           end
         end
       end
+      @thread = if options[:background_fibers] && Utils.fiber_scheduler
+        FiberTask.new(&body)
+      else
+        Thread.new(&body)
+      end
     end
 
     # Waits for the thread to die, with a timeout.
@@ -131,6 +136,11 @@ module Mongo
       # the network is no longer available that could take a long time.
       start_time = Utils.monotonic_time
       ([0.1, 0.15] + [0.2] * 5 + [0.3] * 20).each do |interval|
+        if @thread.is_a?(FiberTask)
+          # Timeout is not safe to use with all fiber schedulers.
+          break if @thread.join(interval)
+          next
+        end
         begin
           Timeout.timeout(interval) do
             @thread.join
@@ -169,5 +179,59 @@ module Mongo
     # thread to stop.
     def pre_stop
     end
+
+    # A background task running as a non-blocking fiber on the fiber
+    # scheduler of the thread that started it, with the subset of the
+    # Thread interface used by BackgroundThread.
+    #
+    # The task runs only while the scheduler runs. Since it performs work in
+    # a loop until stopped, the owning object (typically the client) must be
+    # closed before the scheduler can finish.
+    class FiberTask
+      def initialize(&block)
+        @lock = Mutex.new
+        @done_condition = ConditionVariable.new
+        @done = false
+        @fiber = Fiber.schedule do
+          begin
+            block.call
+          ensure
+            @lock.synchronize do
+              @done = true
+              @done_condition.broadcast
+            end
+          end
+        end
+      end
+
+      def alive?
+        !@done
+      end
+
+      def status
+        @done ? false : 'run'
+      end
+
+      # Waits for the task to finish for up to limit seconds.
+      #
+      # @return [ FiberTask | nil ] The task, or nil if it did not finish
+      #   in time.
+      def join(limit = nil)
+        @lock.synchronize do
+          unless @done
+            @done_condition.wait(@lock, limit)
+          end
+          @done ? self : nil
+        end
+      end
+
+      # Does not terminate the fiber: killing a fiber which is waiting on
+      # a condition variable corrupts the state of the associated mutex.
+      # The task stops on its own once it observes the stop request of its
+      # owner, which pre_stop wakes it up to do.
+      def kill
+        self
+      end
+    end
   end
 end
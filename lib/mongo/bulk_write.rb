@@ -57,41 +57,23 @@ module Mongo
     # @since 2.1.0
     def execute
       operation_id = Monitoring.next_operation_id
-      result_combiner = ResultCombiner.new
       operations = op_combiner.combine
 
+      if concurrent?
+        return execute_concurrently(operations, operation_id).result
+      end
+
+      result_combiner = ResultCombiner.new
       client.send(:with_session, @options) do |session|
         context = Operation::Context.new(client: client, session: session)
         operations.each do |operation|
-          if single_statement?(operation)
-            write_concern = write_concern(session)
-            write_with_retry(session, write_concern) do |server, txn_num|
-              server.with_connection(service_id: context.service_id) do |connection|
-                execute_operation(
-                  operation.keys.first,
-                  operation.values.flatten,
-                  connection,
-                  context,
-                  operation_id,
-                  result_combiner,
-                  session,
-                  txn_num)
-              end
-            end
-          else
-            nro_write_with_retry(session, write_concern) do |server|
-              server.with_connection(service_id: context.service_id) do |connection|
-                execute_operation(
-                  operation.keys.first,
-                  operation.values.flatten,
-                  connection,
-                  context,
-                  operation_id,
-                  result_combiner,
-                  session)
-              end
-            end
-          end
+          execute_batch(
+            operation.keys.first,
+            operation.values.flatten,
+            context,
+            operation_id,
+            result_combiner,
+            session)
         end
       end
       result_combiner.result
@@ -158,14 +140,130 @@ module Mongo
         collection.write_concern_with_session(session)
     end
 
+    # Get the maximum number of batches to send to the server at the same
+    # time, when the bulk write is unordered.
+    #
+    # @api private
+    #
+    # @return [ Integer ] The concurrency.
+    def concurrency
+      @concurrency ||= options[:concurrency] || 1
+    end
+
     private
 
     SINGLE_STATEMENT_OPS = [ :delete_one,
                              :update_one,
                              :insert_one ].freeze
 
-    def single_statement?(operation)
-      SINGLE_STATEMENT_OPS.include?(operation.keys.first)
+    def single_statement?(name)
+      SINGLE_STATEMENT_OPS.include?(name)
+    end
+
+    # Whether the batches of this bulk write are sent concurrently.
+    #
+    # Each batch sent concurrently uses its own implicit session, since
+    # the server serializes operations using the same session. Bulk writes
+    # using an explicit session are therefore executed sequentially.
+    def concurrent?
+      !ordered? && concurrency > 1 && !options[:session]
+    end
+
+    def execute_batch(name, values, context, operation_id, result_combiner, session)
+      if single_statement?(name)
+        write_concern = write_concern(session)
+        write_with_retry(session, write_concern, context: context) do |server, txn_num|
+          server.with_connection(service_id: context.service_id, timeout: context.remaining_timeout_sec) do |connection|
+            execute_operation(
+              name,
+              values,
+              connection,
+              context,
+              operation_id,
+              result_combiner,
+              session,
+              txn_num)
+          end
+        end
+      else
+        nro_write_with_retry(session, write_concern, context: context) do |server|
+          server.with_connection(service_id: context.service_id, timeout: context.remaining_timeout_sec) do |connection|
+            execute_operation(
+              name,
+              values,
+              connection,
+              context,
+              operation_id,
+              result_combiner,
+              session)
+          end
+        end
+      end
+    end
+
+    # Splits the operations into batches of at most the server's maximum
+    # write batch size and sends up to #concurrency batches at a time, each
+    # on its own pooled connection.
+    #
+    # Results of each batch are collected separately, then merged in batch
+    # order, so that the combined result (including the indexes of write
+    # errors) is the same as if the batches had been sent sequentially.
+    #
+    # @return [ ResultCombiner ] The combined results.
+    def execute_concurrently(operations, operation_id)
+      # The query cache is thread-local, thus it must be cleared in the
+      # calling thread rather than in the worker threads.
+      QueryCache.clear_namespace(collection.namespace)
+
+      batch_size = next_primary.description.max_write_batch_size
+      batches = operations.map do |operation|
+        name = operation.keys.first
+        operation.values.flatten.each_slice(batch_size).map do |values|
+          [name, values]
+        end
+      end.flatten(1)
+
+      combiners = Array.new(batches.length) { ResultCombiner.new }
+      queue = Queue.new
+      batches.each_index { |index| queue << index }
+      lock = Mutex.new
+      error = nil
+
+      threads = Array.new([concurrency, batches.length].min) do
+        Thread.new do
+          Thread.current.report_on_exception = false
+          begin
+            client.send(:with_session, @options) do |session|
+              context = Operation::Context.new(client: client, session: session)
+              loop do
+                # Stop sending new batches once any batch failed.
+                break if lock.synchronize { error }
+
+                index = begin
+                  queue.pop(true)
+                rescue ThreadError
+                  break
+                end
+
+                name, values = batches[index]
+                execute_batch(name, values, context, operation_id,
+                  combiners[index], session)
+              end
+            end
+          rescue Exception => e
+            lock.synchronize do
+              error ||= e
+            end
+          end
+        end
+      end
+      threads.each(&:join)
+
+      raise error if error
+
+      combiners.each_with_object(ResultCombiner.new) do |combiner, result_combiner|
+        result_combiner.merge!(combiner)
+      end
     end
 
     def base_spec(operation_id, session)
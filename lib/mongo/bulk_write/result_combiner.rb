@@ -72,6 +72,35 @@ module Mongo
         @count += count
       end
 
+      # Adds the results collected by another combiner, for requests which
+      # follow the requests combined so far, to the overall results.
+      #
+      # @api private
+      #
+      # @example Merge the results of another combiner.
+      #   combiner.merge!(other)
+      #
+      # @param [ ResultCombiner ] other The combiner to merge.
+      #
+      # @return [ ResultCombiner ] self.
+      def merge!(other)
+        other.results.each do |field, value|
+          results[field] = if field == 'writeErrors'
+            (results[field] || []) + value.map do |error|
+              error.merge('index' => count + error['index'])
+            end
+          elsif value.is_a?(Array)
+            # Inserted and upserted ids, write concern errors.
+            (results[field] || []) + value
+          else
+            # Counts.
+            (results[field] || 0) + value
+          end
+        end
+        @count += other.count
+        self
+      end
+
       # Get the final result.
       #
       # @api private
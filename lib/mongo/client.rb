@@ -58,23 +58,30 @@ module Mongo
       :auth_mech_properties,
       :auth_source,
       :auto_encryption_options,
+      :background_fibers,
       :bg_error_backtrace,
       :cleanup,
+      :compression_threshold,
       :compressors,
       :direct_connection,
       :connect,
       :connect_timeout,
       :database,
       :heartbeat_frequency,
+      :hedged_read_delay,
+      :hedged_reads,
       :id_generator,
       :load_balanced,
       :local_threshold,
       :logger,
       :log_prefix,
+      :max_connecting,
       :max_idle_time,
       :max_pool_size,
       :max_read_retries,
       :max_write_retries,
+      :metrics,
+      :metrics_sample_rate,
       :min_pool_size,
       :monitoring,
       :monitoring_io,
@@ -90,7 +97,9 @@ module Mongo
       :scan,
       :sdam_proc,
       :server_api,
+      :server_selection_strategy,
       :server_selection_timeout,
+      :shared_monitoring,
       :socket_timeout,
       :ssl,
       :ssl_ca_cert,
@@ -107,6 +116,7 @@ module Mongo
       :ssl_verify_certificate,
       :ssl_verify_hostname,
       :ssl_verify_ocsp_endpoint,
+      :timeout_ms,
       :truncate_logs,
       :user,
       :wait_queue_timeout,
@@ -114,6 +124,7 @@ module Mongo
       :write,
       :write_concern,
       :zlib_compression_level,
+      :zstd_compression_level,
     ].freeze
 
     # The compression algorithms supported by the driver.
@@ -160,6 +171,19 @@ module Mongo
     end
     private :monitoring
 
+    # Get the command and connection pool metrics collected for this client.
+    #
+    # @example Export the metrics.
+    #   client.metrics.to_prometheus
+    #
+    # @return [ Monitoring::Metrics | nil ] The metrics, or nil if the
+    #   client was not created with the :metrics option.
+    #
+    # @since 2.16.0
+    def metrics
+      monitoring.metrics
+    end
+
     # Determine if this client is equivalent to another object.
     #
     # @example Check client equality.
@@ -230,10 +254,20 @@ module Mongo
     #   use. One of :mongodb_cr, :mongodb_x509, :plain, :scram, :scram256
     # @option options [ Hash ] :auth_mech_properties
     # @option options [ String ] :auth_source The source to authenticate from.
+    # @option options [ true, false ] :background_fibers Whether to run the
+    #   driver background tasks (server monitors, connection pool populators and
+    #   the periodic executor) as fibers on the Fiber scheduler of the thread
+    #   creating them, rather than in their own threads. Has no effect when no
+    #   scheduler is set. When this option is used, the client must be closed for
+    #   the scheduler to finish. Defaults to false.
     # @option options [ true | false | nil | Integer ] :bg_error_backtrace
     #   Experimental. Set to true to log complete backtraces for errors in
     #   background threads. Set to false or nil to not log backtraces. Provide
     #   a positive integer to log up to that many backtrace lines.
+    # @option options [ Integer ] :compression_threshold The minimum size, in
+    #   bytes, of an uncompressed message for it to be compressed. Smaller
+    #   messages are sent uncompressed. By default all messages that permit
+    #   compression are compressed.
     # @option options [ Array<String> ] :compressors A list of potential
     #   compressors to use, in order of preference. The driver chooses the
     #   first compressor that is also supported by the server. Currently the
@@ -253,6 +287,16 @@ module Mongo
     # @option options [ String ] :database The database to connect to.
     # @option options [ Float ] :heartbeat_frequency The interval, in seconds,
     #   for the server monitor to refresh its description via hello.
+    # @option options [ Float ] :hedged_read_delay The time, in seconds, to wait
+    #   for the reply of the first server before hedging a read. Defaults to the
+    #   90th percentile of the recent round trip times to the server, but at least
+    #   10 milliseconds.
+    # @option options [ true | false ] :hedged_reads Whether to hedge nearest
+    #   and secondary preferred reads of collection views in replica sets: if the
+    #   server the initial query of a find or aggregation is sent to has not
+    #   replied within the hedged read delay, the query is also sent to another
+    #   suitable server, the first successful reply is used and the cursor opened
+    #   by the other query is killed. Defaults to false.
     # @option options [ Object ] :id_generator A custom object to generate ids
     #   for documents. Must respond to #generate.
     # @option options [ true | false ] :load_balanced Whether to expect to
@@ -263,6 +307,10 @@ module Mongo
     # @option options [ String ] :log_prefix A custom log prefix to use when
     #   logging. This option is experimental and subject to change in a future
     #   version of the driver.
+    # @option options [ Integer ] :max_connecting The maximum number of
+    #   connections that the connection pool for each server establishes
+    #   concurrently; further connection requests wait for these connections to be
+    #   established. Must be positive. Defaults to 2.
     # @option options [ Integer ] :max_idle_time The maximum seconds a socket can remain idle
     #   since it has been checked in to the pool.
     # @option options [ Integer ] :max_pool_size The maximum size of the
@@ -271,6 +319,13 @@ module Mongo
     #   retries when legacy read retries are in use.
     # @option options [ Integer ] :max_write_retries The maximum number of write
     #   retries when legacy write retries are in use.
+    # @option options [ true, false ] :metrics Whether to collect command
+    #   latency histograms and connection pool metrics in process, retrievable via
+    #   Client#metrics. Defaults to false.
+    # @option options [ Float ] :metrics_sample_rate The fraction of command,
+    #   check out and connection creation latencies recorded in metrics
+    #   histograms, greater than 0 and at most 1. Counters are always exact.
+    #   Defaults to 1.
     # @option options [ Integer ] :min_pool_size The minimum size of the
     #   connection pool.
     # @option options [ true, false ] :monitoring If false is given, the
@@ -336,8 +391,23 @@ module Mongo
     #   - *:version* -- string
     #   - *:strict* -- boolean
     #   - *:deprecation_errors* -- boolean
+    # @option options [ Symbol ] :server_selection_strategy How to choose among
+    #   the servers suitable for an operation: :random (the default) picks one of
+    #   them at random; :power_of_two_choices picks two of them at random and uses
+    #   the one with fewer operations in progress, steering operations away from
+    #   overloaded servers.
     # @option options [ Integer ] :server_selection_timeout The timeout in seconds
     #   for selecting a server for an operation.
+    # @option options [ true | false ] :shared_monitoring Whether to share the
+    #   monitoring of each server with other clients created with this option and
+    #   the same address and monitoring related options (TLS, timeouts, heartbeat
+    #   frequency, compression, server API and application metadata options). The
+    #   process then runs one monitoring thread and set of monitoring connections
+    #   per server for all such clients. A client monitoring a server that is
+    #   already monitored obtains its description without waiting for a check, and
+    #   creates the connection pools of data-bearing servers right away, so that
+    #   they are populated up to :min_pool_size. Server heartbeat events are not
+    #   published for shared monitors. Defaults to false.
     # @option options [ Float ] :socket_timeout The timeout, in seconds, to
     #   execute operations on a socket.
     # @option options [ true, false ] :ssl Whether to use TLS.
@@ -396,6 +466,13 @@ module Mongo
     # @option options [ true, false ] :ssl_verify_hostname Whether to perform peer hostname
     #   validation. This setting overrides :ssl_verify with respect to whether hostname validation
     #   is performed.
+    # @option options [ Integer ] :timeout_ms The time, in milliseconds, in
+    #   which each operation must complete, including server selection, connection
+    #   check out, retries and reading the reply. The time remaining is sent to
+    #   the server as maxTimeMS. When the time elapses, the operation fails with
+    #   Mongo::Error::TimeoutError or, if the time elapses while reading the
+    #   reply, with Mongo::Error::SocketTimeoutError, and is not retried. Cursors
+    #   apply the timeout to each batch. Zero means no timeout.
     # @option options [ true, false ] :truncate_logs Whether to truncate the
     #   logs at the default 250 characters.
     # @option options [ String ] :user The user name.
@@ -412,6 +489,9 @@ module Mongo
     #   :j => Boolean, :fsync => Boolean.
     # @option options [ Integer ] :zlib_compression_level The Zlib compression level to use, if using compression.
     #   See Ruby's Zlib module for valid levels.
+    # @option options [ Integer ] :zstd_compression_level The zstd compression
+    #   level to use, if using compression. See the zstd-ruby library for valid
+    #   levels.
     # @option options [ Hash ] :resolv_options For internal driver use only.
     #   Options to pass through to Resolv::DNS constructor for SRV lookups.
     # @option options [ Hash ] :auto_encryption_options Auto-encryption related
@@ -436,6 +516,7 @@ module Mongo
     #   - :bypass_auto_encryption => Boolean, when true, disables auto encryption;
     #     defaults to false.
     #   - :extra_options => Hash | nil, options related to spawning mongocryptd
+    #     and caching data keys
     #     (this part of the API is subject to change).
     #
     #   Notes on automatic encryption:
@@ -991,6 +1072,10 @@ module Mongo
     #   wait on new documents to satisfy a change stream query.
     # @option options [ Integer ] :batch_size The number of documents to return per batch.
     # @option options [ BSON::Document, Hash ] :collation The collation to use.
+    # @option options [ true, false ] :prefetch Whether to send the awaited
+    #   getMore for the next batch in a background thread as soon as the
+    #   current batch is returned by the server. Only used with implicit
+    #   sessions.
     # @option options [ Session ] :session The session to use.
     # @option options [ BSON::Timestamp ] :start_at_operation_time Only return
     #   changes that occurred at or after the specified timestamp. Any command run
@@ -1008,7 +1093,7 @@ module Mongo
       return use(Database::ADMIN).watch(pipeline, options) unless database.name == Database::ADMIN
 
       Mongo::Collection::View::ChangeStream.new(
-        Mongo::Collection::View.new(self["#{Database::COMMAND}.aggregate"]),
+        Mongo::Collection::View.new(self["#{Database::COMMAND}.aggregate"], {}, Utils.slice_hash(options, :prefetch)),
         pipeline,
         Mongo::Collection::View::ChangeStream::CLUSTER,
         options)
@@ -1203,6 +1288,24 @@ module Mongo
         end
       end
 
+      if strategy = opts[:server_selection_strategy]
+        unless %i(random power_of_two_choices).include?(strategy)
+          raise ArgumentError, "Invalid server selection strategy: #{strategy}"
+        end
+      end
+
+      if timeout_ms = opts[:timeout_ms]
+        unless timeout_ms.is_a?(Integer) && timeout_ms >= 0
+          raise ArgumentError, "Invalid timeout_ms: #{timeout_ms}"
+        end
+      end
+
+      if delay = opts[:hedged_read_delay]
+        unless delay.is_a?(Numeric) && delay >= 0
+          raise ArgumentError, "Invalid hedged read delay: #{delay}"
+        end
+      end
+
       Lint.validate_underscore_read_preference(opts[:read])
       Lint.validate_read_concern_option(opts[:read_concern])
       opts.each.inject(Options::Redacted.new) do |_options, (k, v)|
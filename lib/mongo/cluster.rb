@@ -206,7 +206,7 @@ module Mongo
         @cursor_reaper = CursorReaper.new(self)
         @socket_reaper = SocketReaper.new(self)
         @periodic_executor = PeriodicExecutor.new([
-          @cursor_reaper, @socket_reaper,
+          @cursor_reaper, @socket_reaper, session_pool,
         ], options)
 
         @periodic_executor.run!
@@ -339,6 +339,18 @@ module Mongo
       end
     end
 
+    # Returns statistics about the cursors scheduled to be killed by the
+    # cluster's cursor reaper, or nil if the cluster does not reap cursors.
+    #
+    # @return [ Hash | nil ] The statistics. See CursorReaper#stats.
+    #
+    # @api private
+    def cursor_reaper_stats
+      if options[:cleanup] != false && @cursor_reaper
+        @cursor_reaper.stats
+      end
+    end
+
     # @api private
     attr_reader :srv_monitor
 
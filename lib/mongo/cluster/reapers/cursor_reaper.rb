@@ -34,6 +34,20 @@ module Mongo
       # @since 2.3.0
       FREQUENCY = 1.freeze
 
+      # The maximum number of cursor ids sent in a single killCursors
+      # command.
+      #
+      # @api private
+      MAX_CURSOR_IDS_PER_COMMAND = 1000
+
+      # The maximum number of killCursors commands sent each time the
+      # reaper executes. Cursors beyond this limit remain scheduled and are
+      # killed on subsequent executions, so that abandoning many cursors
+      # does not take connections away from application operations.
+      #
+      # @api private
+      MAX_COMMANDS_PER_EXECUTION = 10
+
       # Create a cursor reaper.
       #
       # @param [ Cluster ] cluster The cluster.
@@ -43,7 +57,15 @@ module Mongo
         @cluster = cluster
         @to_kill = {}
         @active_cursor_ids = Set.new
+        @scheduled_at = {}
         @mutex = Mutex.new
+        @stats = {
+          cursors_killed: 0,
+          commands_sent: 0,
+          commands_failed: 0,
+          last_latency: nil,
+          max_latency: nil,
+        }
       end
 
       attr_reader :cluster
@@ -60,6 +82,7 @@ module Mongo
           if @active_cursor_ids.include?(kill_spec.cursor_id)
             @to_kill[server.address.seed] ||= Set.new
             @to_kill[server.address.seed] << kill_spec
+            @scheduled_at[kill_spec.cursor_id] ||= Utils.monotonic_time
           end
         end
       end
@@ -107,86 +130,166 @@ module Mongo
 
         @mutex.synchronize do
           @active_cursor_ids.delete(id)
+          @scheduled_at.delete(id)
         end
       end
 
-      # Execute all pending kill cursors operations.
+      # Returns statistics about the cursors scheduled to be killed and
+      # the killCursors commands sent by the reaper.
+      #
+      # @return [ Hash ] The statistics, with the following keys:
+      #   - *:backlog* -- the number of cursors scheduled to be killed.
+      #   - *:oldest_scheduled_age* -- the time in seconds since the oldest
+      #     scheduled cursor was scheduled, or nil if there is none.
+      #   - *:cursors_killed* -- the number of cursors killed.
+      #   - *:commands_sent* -- the number of killCursors commands sent.
+      #   - *:commands_failed* -- the number of killCursors commands that
+      #     failed.
+      #   - *:last_latency* -- the time in seconds between scheduling and
+      #     killing of the longest waiting cursor in the most recent
+      #     killCursors command.
+      #   - *:max_latency* -- the largest such time observed.
+      #
+      # @api private
+      def stats
+        @mutex.synchronize do
+          oldest = @scheduled_at.values.min
+          @stats.merge(
+            backlog: @to_kill.values.sum(&:size),
+            oldest_scheduled_age: oldest && Utils.monotonic_time - oldest,
+          )
+        end
+      end
+
+      # Send killCursors commands for the scheduled cursors.
+      #
+      # The cursors scheduled for the same server, database, collection
+      # and service id are killed by a single command, with up to
+      # MAX_CURSOR_IDS_PER_COMMAND cursor ids. At most
+      # MAX_COMMANDS_PER_EXECUTION commands are sent by each call.
       #
       # @example Execute pending kill cursors operations.
       #   cursor_reaper.kill_cursors
       #
+      # @return [ Integer ] The number of commands sent.
+      #
       # @api private
       #
       # @since 2.3.0
       def kill_cursors
-        # TODO optimize this to batch kill cursor operations for the same
-        # server/database/collection instead of killing each cursor
-        # individually.
+        batches = take_batches(MAX_COMMANDS_PER_EXECUTION)
+        batches.each do |batch|
+          kill_batch(batch)
+        end
+        batches.length
+      end
+      alias :execute :kill_cursors
 
+      # Send killCursors commands for all scheduled cursors, without
+      # limiting the number of commands sent.
+      #
+      # @api private
+      def flush
         loop do
-          server_address_str = nil
+          break if kill_cursors == 0
+        end
+      end
 
-          kill_spec = @mutex.synchronize do
-            # Find a server that has any cursors scheduled for destruction.
-            server_address_str, specs =
-              @to_kill.detect { |server_address_str, specs| specs.any? }
+      private
 
-            if specs.nil?
-              # All servers have empty specs, nothing to do.
-              return
+      # Removes up to max_commands batches of kill specs from the queue.
+      # Kill specs whose cursors are no longer active are discarded.
+      #
+      # Note that a batch whose killCursors command fails is not retried.
+      def take_batches(max_commands)
+        @mutex.synchronize do
+          batches = []
+          @to_kill.each do |server_address_str, specs|
+            groups = {}
+            inactive = []
+            specs.each do |spec|
+              if @active_cursor_ids.include?(spec.cursor_id)
+                key = [spec.db_name, spec.coll_name, spec.service_id]
+                (groups[key] ||= []) << spec
+              else
+                # The cursor was already killed, typically because it has
+                # been iterated to completion.
+                inactive << spec
+              end
             end
-
-            # Note that this mutates the spec in the queue.
-            # If the kill cursor operation fails, we don't attempt to
-            # kill that cursor again.
-            spec = specs.take(1).tap do |arr|
-              specs.subtract(arr)
-            end.first
-
-            unless @active_cursor_ids.include?(spec.cursor_id)
-              # The cursor was already killed, typically because it has
-              # been iterated to completion. Remove the kill spec from
-              # our records without doing any more work.
-              spec = nil
+            specs.subtract(inactive)
+            inactive.each do |spec|
+              @scheduled_at.delete(spec.cursor_id)
             end
-
-            spec
+            groups.each_value do |group|
+              group.each_slice(MAX_CURSOR_IDS_PER_COMMAND) do |slice|
+                break if batches.length >= max_commands
+                batches << [server_address_str, slice]
+              end
+            end
+            break if batches.length >= max_commands
           end
 
-          # If there was a spec to kill but its cursor was already killed,
-          # look for another spec.
-          next unless kill_spec
-
-          # We could also pass kill_spec directly into the KillCursors
-          # operation, though this would make that operation have a
-          # different API from all of the other ones which accept hashes.
-          spec = {
-            cursor_ids: [kill_spec.cursor_id],
-            coll_name: kill_spec.coll_name,
-            db_name: kill_spec.db_name,
-          }
-          op = Operation::KillCursors.new(spec)
-
-          server = cluster.servers.detect do |server|
-            server.address.seed == server_address_str
+          now = Utils.monotonic_time
+          batches.map do |server_address_str, slice|
+            @to_kill[server_address_str].subtract(slice)
+            scheduled_at = slice.map do |spec|
+              @scheduled_at.delete(spec.cursor_id)
+            end.compact.min
+            [server_address_str, slice, scheduled_at && now - scheduled_at]
           end
+        end
+      end
 
-          unless server
-            # TODO We currently don't have a server for the address that the
-            # cursor is associated with. We should leave the cursor in the
-            # queue to be killed at a later time (when the server comes back).
-            next
-          end
+      def kill_batch(batch)
+        server_address_str, kill_specs, latency = batch
+
+        server = cluster.servers.detect do |server|
+          server.address.seed == server_address_str
+        end
 
-          options = {
-            server_api: server.options[:server_api],
-            service_id: kill_spec.service_id,
-          }
+        unless server
+          # TODO We currently don't have a server for the address that the
+          # cursor is associated with. We should leave the cursor in the
+          # queue to be killed at a later time (when the server comes back).
+          return
+        end
+
+        kill_spec = kill_specs.first
+        # We could also pass kill_spec directly into the KillCursors
+        # operation, though this would make that operation have a
+        # different API from all of the other ones which accept hashes.
+        spec = {
+          cursor_ids: kill_specs.map(&:cursor_id),
+          coll_name: kill_spec.coll_name,
+          db_name: kill_spec.db_name,
+        }
+        op = Operation::KillCursors.new(spec)
+
+        options = {
+          server_api: server.options[:server_api],
+          service_id: kill_spec.service_id,
+        }
+        begin
           op.execute(server, context: Operation::Context.new(options: options))
+        rescue Error
+          @mutex.synchronize do
+            @stats[:commands_failed] += 1
+          end
+          return
+        end
+
+        @mutex.synchronize do
+          @stats[:commands_sent] += 1
+          @stats[:cursors_killed] += kill_specs.length
+          if latency
+            @stats[:last_latency] = latency
+            if @stats[:max_latency].nil? || latency > @stats[:max_latency]
+              @stats[:max_latency] = latency
+            end
+          end
         end
       end
-      alias :execute :kill_cursors
-      alias :flush :kill_cursors
     end
   end
 end
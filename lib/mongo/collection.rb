@@ -17,6 +17,7 @@
 
 require 'mongo/bulk_write'
 require 'mongo/collection/view'
+require 'mongo/collection/write_coalescer'
 
 module Mongo
 
@@ -56,7 +57,7 @@ module Mongo
     # Options that can be updated on a new Collection instance via the #with method.
     #
     # @since 2.1.0
-    CHANGEABLE_OPTIONS = [ :read, :read_concern, :write, :write_concern ].freeze
+    CHANGEABLE_OPTIONS = [ :read, :read_concern, :write, :write_concern, :coalesce_writes ].freeze
 
     # Options that can be used for creating a time-series collection.
     TIME_SERIES_OPTIONS = {
@@ -98,6 +99,13 @@ module Mongo
     #   information about time-series collection.
     # @option options [ Integer ] :expire_after Number indicating
     #   after how many seconds old time-series data should be deleted.
+    # @option options [ true | Hash ] :coalesce_writes Whether to combine
+    #   insert_one calls made concurrently on this collection instance, by
+    #   different threads, into unordered bulk writes. May be a hash with
+    #   :window, the time in seconds to wait for more documents (default
+    #   0.0005), and :max_batch_size (default 1000). Only inserts given no
+    #   options are coalesced. Since coalescing happens per collection
+    #   instance, the instance must be shared between the inserting threads.
     #
     # @since 2.0.0
     def initialize(database, name, options = {})
@@ -108,6 +116,9 @@ module Mongo
       @database = database
       @name = name.to_s.freeze
       @options = options.dup
+      if @options[:coalesce_writes]
+        @write_coalescer = WriteCoalescer.new(self, @options[:coalesce_writes])
+      end
 =begin WriteConcern object support
       if @options[:write_concern].is_a?(WriteConcern::Base)
         # Cache the instance so that we do not needlessly reconstruct it.
@@ -263,6 +274,7 @@ module Mongo
       operation = { :create => name }.merge(options)
       operation.delete(:write)
       operation.delete(:write_concern)
+      operation.delete(:coalesce_writes)
       client.send(:with_session, opts) do |session|
         write_concern = if opts[:write_concern]
           WriteConcern.get(opts[:write_concern])
@@ -355,8 +367,17 @@ module Mongo
     #   Set this option to prevent that.
     # @option options [ true, false ] :oplog_replay For internal replication
     #   use only, applications should not set this option.
+    # @option options [ true, false ] :prefetch Whether to send the getMore
+    #   for the next batch in a background thread as soon as the current
+    #   batch is returned by the server, overlapping network latency with
+    #   the application's processing of the current batch. Only used with
+    #   implicit sessions.
     # @option options [ Hash ] :projection The fields to include or exclude from each doc
     #   in the result set.
+    # @option options [ true, false ] :raw Whether to return the documents
+    #   as Mongo::RawDocument instances, which are backed by the serialized
+    #   BSON returned by the server and deserialize fields only when they are
+    #   accessed. Queries with this option bypass the query cache.
     # @option options [ Session ] :session The session to use.
     # @option options [ Integer ] :skip The number of docs to skip before returning results.
     # @option options [ Hash ] :sort The key and direction pairs by which the result set
@@ -424,6 +445,10 @@ module Mongo
     # @option options [ Integer ] :batch_size The number of documents to return
     #   per batch.
     # @option options [ BSON::Document, Hash ] :collation The collation to use.
+    # @option options [ true, false ] :prefetch Whether to send the awaited
+    #   getMore for the next batch in a background thread as soon as the
+    #   current batch is returned by the server. Only used with implicit
+    #   sessions.
     # @option options [ Session ] :session The session to use.
     # @option options [ BSON::Timestamp ] :start_at_operation_time Only return
     #   changes that occurred at or after the specified timestamp. Any command run
@@ -576,12 +601,22 @@ module Mongo
     #
     # @option opts [ Session ] :session The session to use for the operation.
     #
-    # @return [ Result ] The database response wrapper.
+    # @return [ Result ] The database response wrapper. When the collection
+    #   was created with the :coalesce_writes option and no options are
+    #   given, the insert may be combined with concurrent inserts and the
+    #   result only describes the document inserted by this call.
     #
     # @since 2.0.0
     def insert_one(document, opts = {})
       QueryCache.clear_namespace(namespace)
 
+      if @write_coalescer && @write_coalescer.coalescible?(opts)
+        if document.nil?
+          raise ArgumentError, "Document to be inserted cannot be nil"
+        end
+        return @write_coalescer.insert_one(document)
+      end
+
       client.send(:with_session, opts) do |session|
         write_concern = if opts[:write_concern]
           WriteConcern.get(opts[:write_concern])
@@ -593,7 +628,8 @@ module Mongo
           raise ArgumentError, "Document to be inserted cannot be nil"
         end
 
-        write_with_retry(session, write_concern) do |server, txn_num|
+        context = Operation::Context.new(client: client, session: session)
+        write_with_retry(session, write_concern, context: context) do |server, txn_num|
           Operation::Insert.new(
             :documents => [ document ],
             :db_name => database.name,
@@ -604,7 +640,7 @@ module Mongo
             :id_generator => client.options[:id_generator],
             :session => session,
             :txn_num => txn_num,
-          ).execute(server, context: Operation::Context.new(client: client, session: session))
+          ).execute(server, context: context)
         end
       end
     end
@@ -617,6 +653,8 @@ module Mongo
     # @param [ Array<Hash> ] documents The documents to insert.
     # @param [ Hash ] options The insert options.
     #
+    # @option options [ Integer ] :concurrency The maximum number of batches
+    #   to send at the same time when the insert is unordered.
     # @option options [ true | false ] :ordered Whether the operations
     #   should be executed in order.
     # @option options [ Session ] :session The session to use for the operation.
@@ -645,6 +683,10 @@ module Mongo
     #   Can be :w => Integer, :fsync => Boolean, :j => Boolean.
     # @option options [ true, false ] :bypass_document_validation Whether or
     #   not to skip document level validation.
+    # @option options [ Integer ] :concurrency The maximum number of batches
+    #   of an unordered bulk write to send at the same time, each over its
+    #   own connection. Ignored for ordered bulk writes and when a session
+    #   is given. Defaults to 1.
     # @option options [ Session ] :session The session to use for the set of operations.
     #
     # @return [ BulkWrite::Result ] The result of the operation.
@@ -48,6 +48,12 @@ module Mongo
         # @deprecated
         REROUTE = 'Rerouting the Aggregation operation to the primary server.'.freeze
 
+        # Pipeline stages reading from the collection given by their 'from'
+        # field.
+        #
+        # @api private
+        FROM_STAGES = %w($lookup $graphLookup).freeze
+
         # Set to true if disk usage is allowed during the aggregation.
         #
         # @example Set disk usage flag.
@@ -133,12 +139,13 @@ module Mongo
           !write?
         end
 
-        def send_initial_query(server, session)
+        def send_initial_query(server, session, context: nil)
           unless valid_server?(server)
             log_warn("Rerouting the Aggregation operation to the primary server - #{server.summary} is not suitable")
             server = cluster.next_primary(nil, session)
           end
-          initial_query_op(session).execute(server, context: Operation::Context.new(client: client, session: session))
+          initial_query_op(session).execute(server,
+            context: context || Operation::Context.new(client: client, session: session))
         end
 
         # Skip, sort, limit, projection are specified as pipeline stages
@@ -151,10 +158,58 @@ module Mongo
             read_preference: view.read_preference,
             collation: options[:collation],
             # Aggregations can read documents from more than one collection,
-            # so they will be cleared on every write operation.
+            # so they will be cleared on every write operation unless the
+            # collections they read from can be determined.
             multi_collection: true,
+            namespaces: referenced_namespaces,
           }
         end
+
+        # Get the namespaces the pipeline reads documents from.
+        #
+        # @return [ Array<String> | nil ] The namespaces, or nil if they
+        #   cannot be determined.
+        def referenced_namespaces
+          namespaces = [collection.namespace]
+          if collect_namespaces(pipeline, namespaces)
+            namespaces.uniq
+          end
+        end
+
+        # Add the namespaces referenced by the stages to the namespaces.
+        #
+        # @return [ true | false ] Whether all referenced namespaces could be
+        #   determined.
+        def collect_namespaces(stages, namespaces)
+          stages.all? do |stage|
+            stage.all? do |name, spec|
+              name = name.to_s
+              if FROM_STAGES.include?(name)
+                from = spec['from'] || spec[:from]
+                sub_pipeline = spec['pipeline'] || spec[:pipeline] || []
+                from.is_a?(String) &&
+                  namespaces << "#{database.name}.#{from}" &&
+                  collect_namespaces(sub_pipeline, namespaces)
+              elsif name == '$unionWith'
+                if spec.is_a?(String)
+                  namespaces << "#{database.name}.#{spec}"
+                else
+                  coll = spec['coll'] || spec[:coll]
+                  sub_pipeline = spec['pipeline'] || spec[:pipeline] || []
+                  coll.is_a?(String) &&
+                    namespaces << "#{database.name}.#{coll}" &&
+                    collect_namespaces(sub_pipeline, namespaces)
+                end
+              elsif name == '$facet'
+                spec.values.all? do |sub_pipeline|
+                  collect_namespaces(sub_pipeline, namespaces)
+                end
+              else
+                true
+              end
+            end
+          end
+        end
       end
     end
   end
@@ -90,6 +90,13 @@ module Mongo
         #   dropped and recreated or newly renamed collections without missing any notifications.
         #
         #   The server will report an error if `startAfter` and `resumeAfter` are both specified.
+        # @option options [ true, false ] :prefetch Whether to send the
+        #   awaited getMore for the next batch in a background thread as soon
+        #   as the current batch is returned by the server. A prefetched batch
+        #   does not advance the resume token until it is returned to the
+        #   application, so that resuming after an error does not skip it.
+        #   Read from the options of the collection view. Only used with
+        #   implicit sessions.
         #
         # @since 2.5.0
         def initialize(view, pipeline, changes_for, options = {})
@@ -150,24 +157,8 @@ module Mongo
         # @since 2.6.0
         def try_next
           raise StopIteration.new if closed?
-          begin
-            doc = @cursor.try_next
-          rescue Mongo::Error => e
-            if !e.change_stream_resumable?
-              raise
-            end
-
-            # Rerun initial aggregation.
-            # Any errors here will stop iteration and break out of this
-            # method.
-
-            # Save cursor's resume token so we can use it
-            # to create a new cursor
-            @resume_token = @cursor.resume_token
-
-            close
-            create_cursor!
-            retry
+          doc = with_resume do
+            @cursor.try_next
           end
 
           # We need to verify each doc has an _id, so we
@@ -178,6 +169,65 @@ module Mongo
           doc
         end
 
+        # Iterate through the batches of documents returned by the change
+        # stream.
+        #
+        # Each batch is yielded together with the resume token following
+        # it, which is the post-batch resume token returned by the server
+        # when there is one, so that applications processing changes in bulk
+        # can record their progress once per batch. Batches in which the
+        # server returned no changes are not yielded; #resume_token
+        # continues to advance while the stream is idle.
+        #
+        # Resumable errors are handled as by #each.
+        #
+        # @example Process the changes in bulk.
+        #   stream.each_batch do |documents, resume_token|
+        #     process(documents)
+        #     save_checkpoint(resume_token)
+        #   end
+        #
+        # @yieldparam [ Array<BSON::Document> ] documents The change stream
+        #   documents of the batch.
+        # @yieldparam [ BSON::Document ] resume_token The resume token
+        #   following the batch.
+        #
+        # @return [ ChangeStream ] self.
+        def each_batch
+          raise StopIteration.new if closed?
+          loop do
+            documents = try_next_batch
+            yield documents, resume_token unless documents.empty?
+          end
+        rescue StopIteration
+          return self
+        end
+
+        # Return the documents of the next batch of the change stream.
+        #
+        # If documents of the current batch have already been returned by
+        # #try_next, the remaining documents of that batch are returned.
+        # Otherwise this method waits up to max_await_time_ms milliseconds
+        # for changes from the server, and returns an empty array if no
+        # changes are received.
+        #
+        # Retries once on a resumable error.
+        #
+        # Raises StopIteration if the change stream is closed.
+        #
+        # @return [ Array<BSON::Document> ] The change stream documents.
+        def try_next_batch
+          raise StopIteration.new if closed?
+          documents = with_resume do
+            @cursor.try_next_batch
+          end
+
+          if documents.any? { |doc| doc['_id'].nil? }
+            raise Error::MissingResumeToken
+          end
+          documents
+        end
+
         def to_enum
           enum = super
           enum.send(:instance_variable_set, '@obj', self)
@@ -266,6 +316,30 @@ module Mongo
           !for_cluster? && !for_database?
         end
 
+        # Executes the block, which reads from the cursor, and recreates
+        # the cursor and executes the block again on a resumable error.
+        def with_resume
+          begin
+            yield
+          rescue Mongo::Error => e
+            if !e.change_stream_resumable?
+              raise
+            end
+
+            # Rerun initial aggregation.
+            # Any errors here will stop iteration and break out of this
+            # method.
+
+            # Save cursor's resume token so we can use it
+            # to create a new cursor
+            @resume_token = @cursor.resume_token
+
+            close
+            create_cursor!
+            retry
+          end
+        end
+
         def create_cursor!
           # clear the cache because we may get a newer or an older server
           # (rolling upgrades)
@@ -45,8 +45,9 @@ module Mongo
         #
         # @yieldparam [ Hash ] Each matching document.
         def each
-          @cursor = if use_query_cache? && cached_cursor
-            cached_cursor
+          cached = use_query_cache? && cached_cursor
+          @cursor = if cached
+            cached
           else
             session = client.send(:get_session, @options)
             select_cursor(session)
@@ -55,7 +56,7 @@ module Mongo
           if use_query_cache?
             # No need to store the cursor in the query cache if there is
             # already a cached cursor stored at this key.
-            QueryCache.set(@cursor, **cache_options) unless cached_cursor
+            QueryCache.set(@cursor, **cache_options) unless cached
 
             # If a query with a limit is performed, the query cache will
             # re-use results from an earlier query with the same or larger
@@ -115,8 +116,9 @@ module Mongo
               Cursor.new(view, result, server, session: session)
             end
           else
-            read_with_retry_cursor(session, server_selector, view) do |server|
-              send_initial_query(server, session)
+            context = Operation::Context.new(client: client, session: session)
+            read_with_retry_cursor(session, server_selector, view, hedge: true, context: context) do |server, attempt_context|
+              send_initial_query(server, attempt_context.session, context: attempt_context)
             end
           end
         end
@@ -183,12 +185,26 @@ module Mongo
           end
         end
 
-        def send_initial_query(server, session = nil)
-          initial_query_op(server, session).execute(server, context: Operation::Context.new(client: client, session: session))
+        def send_initial_query(server, session = nil, context: nil)
+          initial_query_op(server, session).execute(server,
+            context: context || Operation::Context.new(client: client, session: session),
+            options: execution_options)
         end
 
         def use_query_cache?
-          QueryCache.enabled? && !collection.system_collection?
+          # Raw documents are not cached since they retain the entire
+          # server reply they were read from.
+          QueryCache.enabled? && !collection.system_collection? && !options[:raw]
+        end
+
+        # Options for deserializing the replies of the operations that
+        # produce the documents of this view.
+        def execution_options
+          if options[:raw]
+            { raw_batches: true }
+          else
+            {}
+          end
         end
       end
     end
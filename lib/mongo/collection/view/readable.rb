@@ -24,6 +24,13 @@ module Mongo
       # @since 2.0.0
       module Readable
 
+        # The formats supported by #export_to.
+        EXPORT_FORMATS = [ :bson, :extended_json ].freeze
+
+        # The number of bytes accumulated by #export_to before they are
+        # written to the IO object.
+        EXPORT_BUFFER_SIZE = 1024 * 1024
+
         # Execute an aggregation on the collection view.
         #
         # @example Aggregate documents.
@@ -158,7 +165,8 @@ module Mongo
           read_pref = opts[:read] || read_preference
           selector = ServerSelector.get(read_pref || server_selector)
           with_session(opts) do |session|
-            read_with_retry(session, selector) do |server|
+            context = Operation::Context.new(client: client, session: session)
+            read_with_retry(session, selector, context: context) do |server|
               Operation::Count.new(
                 selector: cmd,
                 db_name: database.name,
@@ -168,7 +176,7 @@ module Mongo
                 # For some reason collation was historically accepted as a
                 # string key. Note that this isn't documented as valid usage.
                 collation: opts[:collation] || opts['collation'] || collation,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end.n.to_i
           end
         end
@@ -235,8 +243,8 @@ module Mongo
           read_pref = opts[:read] || read_preference
           selector = ServerSelector.get(read_pref || server_selector)
           with_session(opts) do |session|
-            read_with_retry(session, selector) do |server|
-              context = Operation::Context.new(client: client, session: session)
+            context = Operation::Context.new(client: client, session: session)
+            read_with_retry(session, selector, context: context) do |server|
               if server.description.server_version_gte?('5.0')
                 pipeline = [
                   {'$collStats' => {'count' => {}}},
@@ -306,7 +314,8 @@ module Mongo
           read_pref = opts[:read] || read_preference
           selector = ServerSelector.get(read_pref || server_selector)
           with_session(opts) do |session|
-            read_with_retry(session, selector) do |server|
+            context = Operation::Context.new(client: client, session: session)
+            read_with_retry(session, selector, context: context) do |server|
               Operation::Distinct.new(
                 selector: cmd,
                 db_name: database.name,
@@ -316,11 +325,66 @@ module Mongo
                 # For some reason collation was historically accepted as a
                 # string key. Note that this isn't documented as valid usage.
                 collation: opts[:collation] || opts['collation'] || collation,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end.first['values']
           end
         end
 
+        # Writes the documents matching the query to an IO object, without
+        # deserializing them.
+        #
+        # The documents are retrieved as with the :raw option. With the :bson
+        # format, the serialized documents returned by the server are written
+        # one after another, as in the files produced by mongodump. With the
+        # :extended_json format, each document is transcoded to relaxed
+        # extended JSON and written on its own line, as by mongoexport.
+        #
+        # Combined with the :prefetch option, the next batch is retrieved
+        # while the current one is being written.
+        #
+        # @example Export a collection to a BSON file.
+        #   File.open('users.bson', 'wb') do |file|
+        #     collection.find({}, prefetch: true).export_to(file)
+        #   end
+        #
+        # @param [ IO ] io The object to write the documents to, which must
+        #   respond to #write.
+        # @param [ :bson | :extended_json ] format The output format.
+        #
+        # @return [ Integer ] The number of documents written.
+        #
+        # @raise [ ArgumentError ] If the format is not supported.
+        # @raise [ Error::UnmetDependency ] If the format is :extended_json,
+        #   a document contains a value of a type such as date, binary or
+        #   decimal128, and the bson gem is older than 4.11.
+        def export_to(io, format: :bson)
+          unless EXPORT_FORMATS.include?(format)
+            raise ArgumentError, "Invalid export format: #{format.inspect}"
+          end
+
+          raw_view = options[:raw] ? self : new(options.merge(raw: true))
+          buffer = if format == :bson
+            String.new(encoding: BSON::BINARY)
+          else
+            String.new(encoding: BSON::UTF8)
+          end
+          count = 0
+          raw_view.each do |doc|
+            if format == :bson
+              buffer << doc.bson_bytes
+            else
+              buffer << doc.to_extended_json << "\n"
+            end
+            count += 1
+            if buffer.bytesize >= EXPORT_BUFFER_SIZE
+              io.write(buffer)
+              buffer.clear
+            end
+          end
+          io.write(buffer) unless buffer.empty?
+          count
+        end
+
         # The index that MongoDB will be forced to use for the query.
         #
         # @example Set the index hint.
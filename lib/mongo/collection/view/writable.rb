@@ -77,14 +77,15 @@ module Mongo
               collation: opts[:collation] || opts['collation'] || collation,
             }.compact
 
-            write_with_retry(session, write_concern) do |server, txn_num|
+            context = Operation::Context.new(client: client, session: session)
+            write_with_retry(session, write_concern, context: context) do |server, txn_num|
               Operation::WriteCommand.new(
                 selector: cmd,
                 db_name: database.name,
                 write_concern: write_concern,
                 session: session,
                 txn_num: txn_num,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end.first['value']
         end
@@ -174,14 +175,15 @@ module Mongo
               collation: opts[:collation] || opts['collation'] || collation,
             }.compact
 
-            write_with_retry(session, write_concern) do |server, txn_num|
+            context = Operation::Context.new(client: client, session: session)
+            write_with_retry(session, write_concern, context: context) do |server, txn_num|
               Operation::WriteCommand.new(
                 selector: cmd,
                 db_name: database.name,
                 write_concern: write_concern,
                 session: session,
                 txn_num: txn_num,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end.first['value']
           value unless value.nil? || value.empty?
@@ -224,7 +226,8 @@ module Mongo
               collation: opts[:collation] || opts['collation'] || collation,
             }.compact
 
-            nro_write_with_retry(session, write_concern) do |server|
+            context = Operation::Context.new(client: client, session: session)
+            nro_write_with_retry(session, write_concern, context: context) do |server|
               Operation::Delete.new(
                 deletes: [ delete_doc ],
                 db_name: collection.database.name,
@@ -232,7 +235,7 @@ module Mongo
                 write_concern: write_concern,
                 bypass_document_validation: !!opts[:bypass_document_validation],
                 session: session,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end
         end
@@ -274,7 +277,8 @@ module Mongo
               collation: opts[:collation] || opts['collation'] || collation,
             }.compact
 
-            write_with_retry(session, write_concern) do |server, txn_num|
+            context = Operation::Context.new(client: client, session: session)
+            write_with_retry(session, write_concern, context: context) do |server, txn_num|
               Operation::Delete.new(
                 deletes: [ delete_doc ],
                 db_name: collection.database.name,
@@ -283,7 +287,7 @@ module Mongo
                 bypass_document_validation: !!opts[:bypass_document_validation],
                 session: session,
                 txn_num: txn_num,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end
         end
@@ -334,7 +338,8 @@ module Mongo
               update_doc['upsert'] = true
             end
 
-            write_with_retry(session, write_concern) do |server, txn_num|
+            context = Operation::Context.new(client: client, session: session)
+            write_with_retry(session, write_concern, context: context) do |server, txn_num|
               Operation::Update.new(
                 updates: [ update_doc ],
                 db_name: collection.database.name,
@@ -343,7 +348,7 @@ module Mongo
                 bypass_document_validation: !!opts[:bypass_document_validation],
                 session: session,
                 txn_num: txn_num,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end
         end
@@ -397,7 +402,8 @@ module Mongo
               update_doc['upsert'] = true
             end
 
-            nro_write_with_retry(session, write_concern) do |server|
+            context = Operation::Context.new(client: client, session: session)
+            nro_write_with_retry(session, write_concern, context: context) do |server|
               Operation::Update.new(
                 updates: [ update_doc ],
                 db_name: collection.database.name,
@@ -405,7 +411,7 @@ module Mongo
                 write_concern: write_concern,
                 bypass_document_validation: !!opts[:bypass_document_validation],
                 session: session,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end
         end
@@ -458,7 +464,8 @@ module Mongo
               update_doc['upsert'] = true
             end
 
-            write_with_retry(session, write_concern) do |server, txn_num|
+            context = Operation::Context.new(client: client, session: session)
+            write_with_retry(session, write_concern, context: context) do |server, txn_num|
               Operation::Update.new(
                 updates: [ update_doc ],
                 db_name: collection.database.name,
@@ -467,7 +474,7 @@ module Mongo
                 bypass_document_validation: !!opts[:bypass_document_validation],
                 session: session,
                 txn_num: txn_num,
-              ).execute(server, context: Operation::Context.new(client: client, session: session))
+              ).execute(server, context: context)
             end
           end
         end
@@ -0,0 +1,274 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  class Collection
+
+    # Combines single document inserts performed concurrently on a
+    # collection into unordered bulk writes.
+    #
+    # The first thread to insert a document when no batch is being
+    # collected becomes the leader of the batch: it waits for the
+    # coalescing window to elapse, or for the batch to fill up, then sends
+    # all documents inserted in the meantime by other threads as a single
+    # unordered bulk write. Each thread then receives the result or error
+    # for its own document. Once the document of the leader has been sent,
+    # the leader returns and one of the threads whose documents remain
+    # pending becomes the leader of the next batch.
+    #
+    # @api private
+    class WriteCoalescer
+
+      # The default time, in seconds, to wait for more documents.
+      DEFAULT_WINDOW = 0.0005
+
+      # The default maximum number of documents in a batch.
+      DEFAULT_MAX_BATCH_SIZE = 1000
+
+      # The result of a coalesced insert_one.
+      class InsertResult
+
+        # @param [ Object ] inserted_id The id of the inserted document.
+        # @param [ true | false ] acknowledged Whether the write was
+        #   acknowledged.
+        def initialize(inserted_id, acknowledged)
+          @inserted_id = inserted_id
+          @acknowledged = acknowledged
+        end
+
+        # @return [ Object ] The id of the inserted document.
+        attr_reader :inserted_id
+
+        # @return [ Array<Object> ] The id of the inserted document.
+        def inserted_ids
+          [ inserted_id ]
+        end
+
+        # @return [ Integer ] The number of documents inserted.
+        def n
+          1
+        end
+        alias :written_count :n
+
+        # @return [ true | false ] Whether the write was acknowledged.
+        def acknowledged?
+          @acknowledged
+        end
+
+        # @return [ true ] Always true, since failed inserts raise.
+        def successful?
+          true
+        end
+        alias :ok? :successful?
+      end
+
+      # A pending insert.
+      Entry = Struct.new(:document, :result, :error, :done)
+
+      # Create the write coalescer.
+      #
+      # @param [ Collection ] collection The collection to insert into.
+      # @param [ true | Hash ] options The coalescing options.
+      #
+      # @option options [ Float ] :window The time, in seconds, to wait for
+      #   more documents before sending a batch.
+      # @option options [ Integer ] :max_batch_size The maximum number of
+      #   documents to send in a batch.
+      #
+      # @raise [ ArgumentError ] If the options are invalid.
+      def initialize(collection, options = {})
+        options = {} unless options.is_a?(Hash)
+        @collection = collection
+        @window = options[:window] || DEFAULT_WINDOW
+        @max_batch_size = options[:max_batch_size] || DEFAULT_MAX_BATCH_SIZE
+        if @window < 0
+          raise ArgumentError, "Coalescing window must be non-negative: #{@window}"
+        end
+        if @max_batch_size < 1
+          raise ArgumentError, "Coalescing max batch size must be positive: #{@max_batch_size}"
+        end
+        @lock = Mutex.new
+        @full_condition = ConditionVariable.new
+        @done_condition = ConditionVariable.new
+        @pending = []
+        @leading = false
+      end
+
+      # @return [ Float ] The coalescing window in seconds.
+      attr_reader :window
+
+      # @return [ Integer ] The maximum number of documents in a batch.
+      attr_reader :max_batch_size
+
+      # Whether an insert_one with the given options may be coalesced.
+      #
+      # Inserts specifying any option, for example an explicit session or
+      # a write concern, are performed individually.
+      #
+      # @param [ Hash ] opts The insert_one options.
+      #
+      # @return [ true | false ] Whether the insert may be coalesced.
+      def coalescible?(opts)
+        opts.empty?
+      end
+
+      # Insert a document as part of a batch.
+      #
+      # @param [ Hash ] document The document to insert.
+      #
+      # @return [ InsertResult ] The result.
+      #
+      # @raise [ Error::OperationFailure ] If the document failed to be
+      #   inserted, for example due to a duplicate key.
+      # @raise [ Error ] If the batch failed as a whole.
+      def insert_one(document)
+        entry = Entry.new(with_id(document))
+        lead = @lock.synchronize do
+          @pending << entry
+          @full_condition.signal if @pending.length >= @max_batch_size
+          take_lead
+        end
+
+        until entry.done
+          if lead
+            send_batches(entry)
+          else
+            lead = @lock.synchronize do
+              # Wait until the document is sent, or until the leader
+              # returns without having sent it.
+              @done_condition.wait(@lock) until entry.done || !@leading
+              !entry.done && take_lead
+            end
+          end
+        end
+        raise entry.error if entry.error
+        entry.result
+      end
+
+      private
+
+      # Makes the calling thread the leader if there is no leader.
+      #
+      # Must be called with the lock held.
+      #
+      # @return [ true | false ] Whether the calling thread is the leader.
+      def take_lead
+        if @leading
+          false
+        else
+          @leading = true
+        end
+      end
+
+      # Sends batches of pending inserts until the entry of the leader has
+      # been sent.
+      def send_batches(entry)
+        batch = nil
+        until entry.done
+          batch = @lock.synchronize do
+            deadline = Utils.monotonic_time + @window
+            while @pending.length < @max_batch_size
+              remaining = deadline - Utils.monotonic_time
+              break if remaining <= 0
+              @full_condition.wait(@lock, remaining)
+            end
+            @pending.shift(@max_batch_size)
+          end
+
+          execute(batch)
+          batch = nil
+
+          @lock.synchronize do
+            @done_condition.broadcast
+          end
+        end
+      ensure
+        @lock.synchronize do
+          if batch
+            # The leader was interrupted while sending the batch, whose
+            # documents may or may not have been inserted.
+            error = $! || Error.new('The batch containing the document was interrupted')
+            batch.each do |pending_entry|
+              unless pending_entry.done
+                pending_entry.error = error
+                pending_entry.done = true
+              end
+            end
+          end
+          @leading = false
+          @done_condition.broadcast
+        end
+      end
+
+      def execute(batch)
+        requests = batch.map do |entry|
+          { insert_one: entry.document }
+        end
+        begin
+          @collection.bulk_write(requests, ordered: false)
+        rescue Error::BulkWriteError => e
+          write_errors = {}
+          (e.result[Error::WRITE_ERRORS] || []).each do |error|
+            write_errors[error['index']] = error
+          end
+          batch.each_with_index do |entry, index|
+            if error = write_errors[index]
+              entry.error = Error::OperationFailure.new(
+                error['errmsg'], nil,
+                code: error['code'],
+                code_name: error['codeName'],
+                document: error,
+              )
+            elsif e.result[Error::WRITE_CONCERN_ERRORS]
+              entry.error = e
+            else
+              entry.result = InsertResult.new(document_id(entry.document), true)
+            end
+            entry.done = true
+          end
+        rescue Exception => e
+          batch.each do |entry|
+            entry.error = e
+            entry.done = true
+          end
+        else
+          acknowledged = @collection.write_concern.acknowledged?
+          batch.each do |entry|
+            entry.result = InsertResult.new(document_id(entry.document), acknowledged)
+            entry.done = true
+          end
+        end
+      end
+
+      # Assigns an id to the document, if it does not have one, so that
+      # the id is known regardless of the outcome of the bulk write.
+      def with_id(document)
+        if document_id(document)
+          document
+        else
+          id_generator = @collection.client.options[:id_generator] ||
+            Operation::ObjectIdGenerator.new
+          document.merge(_id: id_generator.generate)
+        end
+      end
+
+      def document_id(document)
+        document.respond_to?(:id) ? document.id : (document['_id'] || document[:_id])
+      end
+    end
+  end
+end
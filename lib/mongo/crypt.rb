@@ -30,6 +30,8 @@ module Mongo
     autoload(:ExplicitDecryptionContext, 'mongo/crypt/explicit_decryption_context')
     autoload(:AutoDecryptionContext, 'mongo/crypt/auto_decryption_context')
     autoload(:EncryptionIO, 'mongo/crypt/encryption_io')
+    autoload(:KeyVaultCache, 'mongo/crypt/key_vault_cache')
+    autoload(:MarkingCache, 'mongo/crypt/marking_cache')
     autoload(:ExplicitEncrypter, 'mongo/crypt/explicit_encrypter')
     autoload(:AutoEncrypter, 'mongo/crypt/auto_encrypter')
   end
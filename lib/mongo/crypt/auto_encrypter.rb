@@ -29,6 +29,7 @@ module Mongo
     #
     # @api private
     class AutoEncrypter
+      include Loggable
 
       attr_reader :mongocryptd_client
       attr_reader :key_vault_client
@@ -40,6 +41,8 @@ module Mongo
         mongocryptd_bypass_spawn: false,
         mongocryptd_spawn_path: 'mongocryptd',
         mongocryptd_spawn_args: ['--idleShutdownTimeoutSecs=60'],
+        key_cache_ttl: 60,
+        marking_cache_size: 1000,
       })
 
       # Set up encryption-related options and instance variables
@@ -88,7 +91,9 @@ module Mongo
             mongocryptd_client: @mongocryptd_client,
             key_vault_namespace: @options[:key_vault_namespace],
             key_vault_client: @key_vault_client,
-            mongocryptd_options: @options[:extra_options]
+            mongocryptd_options: @options[:extra_options],
+            # The connections are closed when the client is closed.
+            reuse_kms_connections: true,
           )
         rescue
           begin
@@ -99,6 +104,16 @@ module Mongo
           end
           raise
         end
+
+        # Start mongocryptd now rather than when server selection for the
+        # first command to be marked times out.
+        if encrypt?
+          begin
+            @encryption_io.spawn_mongocryptd_eagerly
+          rescue => e
+            log_warn("Error spawning mongocryptd in auto encrypter's constructor: #{e.class}: #{e}")
+          end
+        end
       end
 
       # Whether this encrypter should perform encryption (returns false if
@@ -143,6 +158,7 @@ module Mongo
       # @return [ true ] Always true.
       def close
         @mongocryptd_client.close if @mongocryptd_client
+        @encryption_io.close if @encryption_io
 
         true
       end
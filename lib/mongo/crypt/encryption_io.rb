@@ -29,6 +29,10 @@ module Mongo
       # for a discussion and updates on what this timeout should be.
       SOCKET_TIMEOUT = 10
 
+      # The time, in seconds, after which idle KMS connections are closed
+      # instead of being reused.
+      KMS_IDLE_TIMEOUT = 30
+
       # Creates a new EncryptionIO object with information about how to connect
       # to the key vault.
       #
@@ -45,6 +49,16 @@ module Mongo
       # @option mongocryptd_options [ Boolean ] :mongocryptd_bypass_spawn
       # @option mongocryptd_options [ String ] :mongocryptd_spawn_path
       # @option mongocryptd_options [ Array<String> ] :mongocryptd_spawn_args
+      # @option mongocryptd_options [ Numeric ] :key_cache_ttl The time, in
+      #   seconds, for which key documents retrieved from the key vault are
+      #   cached. Keys are not cached if this option is nil or 0.
+      # @option mongocryptd_options [ Integer ] :marking_cache_size The
+      #   maximum number of mongocryptd responses for commands not requiring
+      #   encryption to cache. Responses are not cached if this option is
+      #   nil or 0.
+      # @param [ true | false ] reuse_kms_connections Whether to keep TLS
+      #   connections to KMS endpoints open for reuse. The connections are
+      #   closed by #close, which the owner of this object must then call.
       #
       # @note When being used for auto encryption, all arguments are required.
       #   When being used for explicit encryption, only the key_vault_namespace
@@ -54,7 +68,7 @@ module Mongo
       #   options are not nil and are in the correct format.
       def initialize(
         client: nil, mongocryptd_client: nil, key_vault_namespace:,
-        key_vault_client:, mongocryptd_options: {}
+        key_vault_client:, mongocryptd_options: {}, reuse_kms_connections: false
       )
         validate_key_vault_client!(key_vault_client)
         validate_key_vault_namespace!(key_vault_namespace)
@@ -64,16 +78,31 @@ module Mongo
         @key_vault_db_name, @key_vault_collection_name = key_vault_namespace.split('.')
         @key_vault_client = key_vault_client
         @options = mongocryptd_options
+        if (ttl = @options[:key_cache_ttl]) && ttl > 0
+          @key_cache = KeyVaultCache.new(ttl)
+        end
+        if (size = @options[:marking_cache_size]) && size > 0
+          @marking_cache = MarkingCache.new(size)
+        end
+        @reuse_kms_connections = reuse_kms_connections
+        @kms_sockets = Hash.new { |hash, endpoint| hash[endpoint] = [] }
+        @kms_lock = Mutex.new
       end
 
       # Query for keys in the key vault collection using the provided
-      # filter
+      # filter. Keys found in the key cache are not queried for.
       #
       # @param [ Hash ] filter
       #
       # @return [ Array<BSON::Document> ] The query results
       def find_keys(filter)
-        key_vault_collection.find(filter).to_a
+        if @key_cache
+          @key_cache.fetch(filter) do |query|
+            key_vault_collection.find(query).to_a
+          end
+        else
+          key_vault_collection.find(filter).to_a
+        end
       end
 
       # Insert a document into the key vault collection
@@ -100,6 +129,9 @@ module Mongo
 
       # Send the command to mongocryptd to be marked with intent-to-encrypt markings
       #
+      # Commands with the same shape and schema as a command which
+      # mongocryptd did not mark any fields of are not sent to mongocryptd.
+      #
       # @param [ Hash ] cmd
       #
       # @return [ Hash ] The marked command
@@ -108,32 +140,49 @@ module Mongo
           raise ArgumentError, 'mark_command requires mongocryptd_client to have been passed to the constructor, but it was not'
         end
 
-        # Ensure the response from mongocryptd is deserialized with { mode: :bson }
-        # to prevent losing type information in commands
-        options = { execution_options: { deserialize_as_bson: true } }
-
-        begin
-          response = @mongocryptd_client.database.command(cmd, options)
-        rescue Error::NoServerAvailable => e
-          raise e if @options[:mongocryptd_bypass_spawn]
-
-          spawn_mongocryptd
-          response = @mongocryptd_client.database.command(cmd, options)
+        if @marking_cache
+          @marking_cache.fetch(cmd) do
+            send_mark_command(cmd)
+          end
+        else
+          send_mark_command(cmd)
         end
+      end
+      # Spawn mongocryptd ahead of its first use, unless spawning it is
+      # bypassed. If mongocryptd is already running, the spawned process
+      # exits since it cannot listen on the port in use.
+      #
+      # @return [ Integer | nil ] The process id of the spawned process.
+      def spawn_mongocryptd_eagerly
+        return nil if @options[:mongocryptd_bypass_spawn]
 
-        return response.first
+        spawn_mongocryptd.tap do |pid|
+          # Reap the process when it exits to avoid leaving a zombie.
+          Process.detach(pid)
+        end
       end
 
       # Get information about the AWS encryption key and feed it to the the
       # KmsContext object
       #
+      # If KMS connections are reused, TLS connections to KMS endpoints are
+      # kept open after the response has been read, and reused for
+      # subsequent requests to the same endpoint. If a reused connection
+      # turns out to have been closed by the KMS before any response was
+      # received, the request is retried once on a new connection.
+      #
       # @param [ Mongo::Crypt::KmsContext ] kms_context A KmsContext object
       #   corresponding to one AWS KMS data key. Contains information about
       #   the endpoint at which to establish a TLS connection and the message
       #   to send on that connection.
       def feed_kms(kms_context)
-        with_ssl_socket(kms_context.endpoint) do |ssl_socket|
+        endpoint = kms_context.endpoint
+        ssl_socket = check_out_kms_socket(endpoint)
+        reused = !!ssl_socket
+        ssl_socket ||= connect_kms_socket(endpoint)
 
+        begin
+          received = false
           Timeout.timeout(SOCKET_TIMEOUT, Error::SocketTimeoutError,
             'Socket write operation timed out'
           ) do
@@ -148,14 +197,58 @@ module Mongo
               ssl_socket.sysread(bytes_needed)
             end
 
+            received = true
             kms_context.feed(bytes)
             bytes_needed = kms_context.bytes_needed
           end
+        rescue => e
+          close_kms_socket(ssl_socket)
+          if reused && !received && !e.is_a?(Error::SocketTimeoutError)
+            Logger.logger.debug("Reconnecting to KMS endpoint #{endpoint} after the reused connection failed: #{e.class}: #{e}")
+            reused = false
+            ssl_socket = connect_kms_socket(endpoint)
+            retry
+          end
+          raise Error::KmsError, "Error decrypting data key: #{e.class}: #{e.message}"
+        end
+
+        if @reuse_kms_connections
+          check_in_kms_socket(endpoint, ssl_socket)
+        else
+          close_kms_socket(ssl_socket)
         end
       end
 
+      # Close the KMS connections kept open for reuse.
+      def close
+        sockets = @kms_lock.synchronize do
+          @kms_sockets.values.flatten(1).tap { @kms_sockets.clear }
+        end
+        sockets.each do |ssl_socket, _|
+          close_kms_socket(ssl_socket)
+        end
+        nil
+      end
+
       private
 
+      def send_mark_command(cmd)
+        # Ensure the response from mongocryptd is deserialized with { mode: :bson }
+        # to prevent losing type information in commands
+        options = { execution_options: { deserialize_as_bson: true } }
+
+        begin
+          response = @mongocryptd_client.database.command(cmd, options)
+        rescue Error::NoServerAvailable => e
+          raise e if @options[:mongocryptd_bypass_spawn]
+
+          spawn_mongocryptd
+          response = @mongocryptd_client.database.command(cmd, options)
+        end
+
+        return response.first
+      end
+
       def validate_key_vault_client!(key_vault_client)
         unless key_vault_client
           raise ArgumentError.new('The :key_vault_client option cannot be nil')
@@ -239,18 +332,43 @@ module Mongo
         end
       end
 
-      # Provide a TLS socket to be used for KMS calls in a block API
+      # Returns an idle TLS socket connected to the endpoint, if there is
+      # one which has not been idle for too long.
+      def check_out_kms_socket(endpoint)
+        return nil unless @reuse_kms_connections
+
+        expired = []
+        ssl_socket = @kms_lock.synchronize do
+          sockets = @kms_sockets[endpoint]
+          now = Utils.monotonic_time
+          while (entry = sockets.pop)
+            if now - entry.last < KMS_IDLE_TIMEOUT
+              break entry.first
+            end
+            expired << entry.first
+          end
+        end
+        expired.each { |socket| close_kms_socket(socket) }
+        ssl_socket
+      end
+
+      def check_in_kms_socket(endpoint, ssl_socket)
+        @kms_lock.synchronize do
+          @kms_sockets[endpoint] << [ ssl_socket, Utils.monotonic_time ]
+        end
+      end
+
+      # Create a TLS socket connected to the endpoint to be used for KMS
+      # calls.
       #
       # @param [ String ] endpoint The URI at which to connect the TLS socket.
-      # @yieldparam [ OpenSSL::SSL::SSLSocket ] ssl_socket Yields a TLS socket
-      #   connected to the specified endpoint.
+      #
+      # @return [ OpenSSL::SSL::SSLSocket ] A TLS socket connected to the
+      #   specified endpoint.
       #
       # @raise [ Mongo::Error::KmsError ] If the socket times out or raises
       #   an exception
-      #
-      # @note The socket is always closed when the provided block has finished
-      #   executing
-      def with_ssl_socket(endpoint)
+      def connect_kms_socket(endpoint)
         host, port = endpoint.split(':')
         port ||= 443 # Default port for AWS KMS API
 
@@ -260,34 +378,22 @@ module Mongo
           tcp_socket.setsockopt(::Socket::IPPROTO_TCP, ::Socket::TCP_NODELAY, 1)
 
           ssl_socket = OpenSSL::SSL::SSLSocket.new(tcp_socket)
-          begin
-            # tcp_socket will be closed when ssl_socket is closed
-            ssl_socket.sync_close = true
-            # perform SNI
-            ssl_socket.hostname = "#{host}:#{port}"
-
-            Timeout.timeout(
-              SOCKET_TIMEOUT,
-              Error::SocketTimeoutError,
-              "KMS socket connection timed out after #{SOCKET_TIMEOUT} seconds",
-            ) do
-              ssl_socket.connect
-            end
-
-            yield(ssl_socket)
-          ensure
-            begin
-              Timeout.timeout(
-                SOCKET_TIMEOUT,
-                Error::SocketTimeoutError,
-                'KMS TLS socket close timed out'
-              ) do
-                ssl_socket.sysclose
-              end
-            rescue
-            end
+          # tcp_socket will be closed when ssl_socket is closed
+          ssl_socket.sync_close = true
+          # perform SNI
+          ssl_socket.hostname = "#{host}:#{port}"
+
+          Timeout.timeout(
+            SOCKET_TIMEOUT,
+            Error::SocketTimeoutError,
+            "KMS socket connection timed out after #{SOCKET_TIMEOUT} seconds",
+          ) do
+            ssl_socket.connect
           end
-        ensure
+
+          ssl_socket
+        rescue
+          close_kms_socket(ssl_socket) if ssl_socket
           # Still close tcp socket manually in case TLS socket creation
           # fails.
           begin
@@ -300,10 +406,22 @@ module Mongo
             end
           rescue
           end
+          raise
         end
       rescue => e
         raise Error::KmsError, "Error decrypting data key: #{e.class}: #{e.message}"
       end
+
+      def close_kms_socket(ssl_socket)
+        Timeout.timeout(
+          SOCKET_TIMEOUT,
+          Error::SocketTimeoutError,
+          'KMS TLS socket close timed out'
+        ) do
+          ssl_socket.sysclose
+        end
+      rescue
+      end
     end
   end
 end
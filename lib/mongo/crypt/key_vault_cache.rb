@@ -0,0 +1,195 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  module Crypt
+
+    # Caches data key documents retrieved from the key vault collection.
+    #
+    # libmongocrypt requests keys with a filter of the form
+    # { '$or' => [ { _id: { '$in' => ids } }, { keyAltNames: { '$in' => names } } ] }.
+    # Keys found in the cache and not yet expired are returned without
+    # querying the key vault. Lookups of missing keys performed
+    # concurrently by several threads are merged: while a query is in
+    # flight, threads needing other keys wait for it to complete and then
+    # fetch all of their keys with a single query.
+    #
+    # @api private
+    class KeyVaultCache
+
+      # @param [ Numeric ] ttl The time, in seconds, for which key documents
+      #   are cached.
+      def initialize(ttl)
+        @ttl = ttl
+        @lock = Mutex.new
+        @condition = ConditionVariable.new
+        # Map from key id to [ key document, expiration time ].
+        @keys = {}
+        # Map from key alt name to key id.
+        @alt_names = {}
+        @fetching = false
+        @wanted_ids = []
+        @wanted_alt_names = []
+      end
+
+      # @return [ Numeric ] The time, in seconds, for which key documents
+      #   are cached.
+      attr_reader :ttl
+
+      # Returns the key documents matching the filter, querying the key
+      # vault only for keys which are not cached.
+      #
+      # @param [ Hash ] filter The filter provided by libmongocrypt.
+      #
+      # @yieldparam [ Hash ] filter The filter to query the key vault with.
+      # @yieldreturn [ Array<BSON::Document> ] The matching key documents.
+      #
+      # @return [ Array<BSON::Document> ] The key documents.
+      def fetch(filter)
+        ids, alt_names = parse_filter(filter)
+        unless ids
+          return yield filter
+        end
+
+        @lock.synchronize do
+          loop do
+            cached, missing_ids, missing_alt_names = lookup(ids, alt_names)
+            if missing_ids.empty? && missing_alt_names.empty?
+              return cached
+            end
+
+            @wanted_ids |= missing_ids
+            @wanted_alt_names |= missing_alt_names
+            if @fetching
+              @condition.wait(@lock)
+              next
+            end
+
+            _, query_ids, query_alt_names = lookup(@wanted_ids, @wanted_alt_names)
+            @wanted_ids = []
+            @wanted_alt_names = []
+            @fetching = true
+            begin
+              @lock.unlock
+              begin
+                documents = yield key_filter(query_ids, query_alt_names)
+              ensure
+                @lock.lock
+              end
+              store(documents)
+            ensure
+              @fetching = false
+              @condition.broadcast
+            end
+
+            # Keys that are still missing are not in the key vault;
+            # libmongocrypt reports the error.
+            cached, = lookup(ids, alt_names)
+            return cached
+          end
+        end
+      end
+
+      # Discards all cached keys.
+      def clear
+        @lock.synchronize do
+          @keys.clear
+          @alt_names.clear
+        end
+      end
+
+      private
+
+      # Returns the cached documents for the ids and alt names, and the
+      # ids and alt names which are not cached.
+      def lookup(ids, alt_names)
+        now = Utils.monotonic_time
+        documents = []
+        missing_ids = []
+        missing_alt_names = []
+        ids.each do |id|
+          if document = cached_document(id, now)
+            documents << document
+          else
+            missing_ids << id
+          end
+        end
+        alt_names.each do |name|
+          if (id = @alt_names[name]) && (document = cached_document(id, now))
+            documents << document
+          else
+            missing_alt_names << name
+          end
+        end
+        [ documents.uniq, missing_ids, missing_alt_names ]
+      end
+
+      def cached_document(id, now)
+        document, expires_at = @keys[id]
+        if document && expires_at > now
+          document
+        elsif document
+          @keys.delete(id)
+          nil
+        end
+      end
+
+      def store(documents)
+        expires_at = Utils.monotonic_time + @ttl
+        documents.each do |document|
+          @keys[document['_id']] = [ document, expires_at ]
+          (document['keyAltNames'] || []).each do |name|
+            @alt_names[name] = document['_id']
+          end
+        end
+      end
+
+      def key_filter(ids, alt_names)
+        {
+          '$or' => [
+            { '_id' => { '$in' => ids } },
+            { 'keyAltNames' => { '$in' => alt_names } },
+          ],
+        }
+      end
+
+      # Extracts the requested key ids and alt names from a filter produced
+      # by libmongocrypt, or returns nil if the filter has another form.
+      def parse_filter(filter)
+        clauses = filter['$or'] || filter[:'$or']
+        unless filter.length == 1 && clauses.is_a?(Array)
+          return nil
+        end
+
+        ids = []
+        alt_names = []
+        clauses.each do |clause|
+          return nil unless clause.length == 1
+          field, condition = clause.first
+          values = condition.is_a?(Hash) && (condition['$in'] || condition[:'$in'])
+          return nil unless values.is_a?(Array) && condition.length == 1
+          case field.to_s
+          when '_id' then ids.concat(values)
+          when 'keyAltNames' then alt_names.concat(values)
+          else return nil
+          end
+        end
+        [ ids, alt_names ]
+      end
+    end
+  end
+end
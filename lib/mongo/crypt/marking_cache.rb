@@ -0,0 +1,129 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  module Crypt
+
+    # Caches the responses of mongocryptd for commands which do not
+    # require any field to be encrypted.
+    #
+    # Whether mongocryptd marks a field for encryption depends on the
+    # schema and on the paths of the fields referenced by the command, not
+    # on the values compared to them. Fields are referenced by field names
+    # and, in aggregation expressions, pipelines and the key of distinct,
+    # by string values such as '$ssn'. A command whose shape - its field
+    # names, their order, its string values and the types of its other
+    # values - and schema are identical to those of a command which
+    # mongocryptd reported as having no encrypted placeholders therefore
+    # does not have any either, and its marking is the command itself.
+    #
+    # Responses containing encrypted placeholders are never cached, since
+    # the placeholders contain the values of the command that was marked.
+    #
+    # @api private
+    class MarkingCache
+
+      # The fields added by libmongocrypt to commands sent to mongocryptd,
+      # which mongocryptd removes from the returned command.
+      SCHEMA_FIELDS = %w(jsonSchema isRemoteSchema).freeze
+
+      # @param [ Integer ] size The maximum number of cached responses.
+      def initialize(size)
+        @size = size
+        @lock = Mutex.new
+        @responses = {}
+      end
+
+      # @return [ Integer ] The maximum number of cached responses.
+      attr_reader :size
+
+      # Returns the response of mongocryptd for the command, from the cache
+      # if a command with the same shape and schema is cached.
+      #
+      # @param [ Hash ] cmd The command to be marked, including the schema.
+      #
+      # @yieldreturn [ BSON::Document ] The response of mongocryptd.
+      #
+      # @return [ BSON::Document ] The response.
+      def fetch(cmd)
+        key = cache_key(cmd)
+        cached = @lock.synchronize do
+          if response = @responses.delete(key)
+            # Move the response to the end of the hash, which is kept in
+            # least recently used order.
+            @responses[key] = response
+          end
+        end
+        if cached
+          return cached.merge('result' => command_without_schema(cmd))
+        end
+
+        yield.tap do |response|
+          if response['hasEncryptedPlaceholders'] == false
+            metadata = response.reject { |name, _| name == 'result' }
+            @lock.synchronize do
+              @responses[key] = metadata
+              @responses.shift while @responses.length > @size
+            end
+          end
+        end
+      end
+
+      private
+
+      def cache_key(cmd)
+        key = []
+        cmd.each do |name, value|
+          if name == 'jsonSchema'
+            # The schema is compared by value.
+            key << name << value.to_bson.to_s
+          elsif name == 'isRemoteSchema'
+            key << name << value
+          else
+            key << name << shape(value)
+          end
+        end
+        key
+      end
+
+      def shape(value)
+        case value
+        when Hash
+          value.map { |name, field| [ name.to_s, shape(field) ] }
+        when Array
+          # Encryption of array elements is not supported, and each distinct
+          # element shape is checked the same way regardless of its index.
+          [ Array, value.map { |element| shape(element) }.uniq ]
+        when String, Symbol
+          # String values may reference fields, for example in aggregation
+          # expressions and in the key of distinct, and are compared by value.
+          [ value.class, value.to_s ]
+        else
+          value.class
+        end
+      end
+
+      def command_without_schema(cmd)
+        BSON::Document.new.tap do |result|
+          cmd.each do |name, value|
+            result[name] = value unless SCHEMA_FIELDS.include?(name)
+          end
+        end
+      end
+    end
+  end
+end
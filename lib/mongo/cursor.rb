@@ -198,46 +198,47 @@ module Mongo
     #
     # @api private
     def try_next
-      if @documents.nil?
-        # Since published versions of Mongoid have a copy of old driver cursor
-        # code, our dup call in #process isn't invoked when Mongoid query
-        # cache is active. Work around that by also calling dup here on
-        # the result of #process which might come out of Mongoid's code.
-        @documents = process(@initial_result).dup
-        # the documents here can be an empty array, hence
-        # we may end up issuing a getMore in the first try_next call
-      end
-
-      if @documents.empty?
-        # On empty batches, we cache the batch resume token
-        cache_batch_resume_token
-
-        unless closed?
-          if exhausted?
-            close
-            raise StopIteration
-          end
-          @documents = get_more
-        else
-          raise StopIteration
-        end
-      else
-        # cursor is closed here
-        # keep documents as an empty array
-      end
+      documents = current_batch
 
       # If there is at least one document, cache its _id
-      if @documents[0]
-        cache_resume_token(@documents[0])
+      if documents[0]
+        cache_resume_token(documents[0])
       end
 
       # Cache the batch resume token if we are iterating
       # over the last document, or if the batch is empty
-      if @documents.size <= 1
+      if documents.size <= 1
         cache_batch_resume_token
       end
 
-      return @documents.shift
+      return documents.shift
+    end
+
+    # Return the documents of the current batch which have not been
+    # returned yet, or the next batch from the server if all documents of
+    # the current batch have been returned.
+    #
+    # The batch may be empty if the server returned no documents, for
+    # example when an awaited getMore on a change stream times out. After
+    # this method returns, the resume token of the cursor is the one
+    # following the returned batch.
+    #
+    # @return [ Array<BSON::Document> ] The documents.
+    #
+    # @raise [ StopIteration ] Raised on the calls after the cursor had been
+    #   completely iterated.
+    #
+    # @api private
+    def try_next_batch
+      documents = current_batch
+      @documents = []
+
+      if documents.last
+        cache_resume_token(documents.last)
+      end
+      cache_batch_resume_token
+
+      documents
     end
 
     # Get the batch size.
@@ -273,6 +274,7 @@ module Mongo
     # @raise [ Error::OperationFailure ] If the server cursor close fails.
     # @raise [ Error::SocketError | Error::SocketTimeoutError ] When there is a network error.
     def close
+      discard_prefetch
       return if closed?
 
       unregister
@@ -347,12 +349,23 @@ module Mongo
     # Execute a getMore command and return the batch of documents
     # obtained from the server.
     #
+    # If the next batch is being prefetched, waits for the prefetch to
+    # complete and returns its documents instead.
+    #
     # @return [ Array<BSON::Document> ] The batch of documents
     #
     # @api private
     def get_more
       @get_more_called = true
 
+      if thread = @prefetch_thread
+        @prefetch_thread = nil
+        # Thread#value re-raises any exception the getMore produced, so
+        # errors surface here as they would had the getMore been sent
+        # synchronously.
+        return process(thread.value)
+      end
+
       # Modern retryable reads specification prohibits retrying getMores.
       # Legacy retryable read logic used to retry getMores, but since
       # doing so may result in silent data loss, the driver no longer retries
@@ -361,6 +374,21 @@ module Mongo
       process(execute_operation(get_more_operation))
     end
 
+    # Whether this cursor prefetches the next batch in the background while
+    # the current batch is being iterated.
+    #
+    # Prefetching requires the :prefetch option on the view, and is only
+    # performed with implicit sessions since sessions must not be used
+    # concurrently by multiple threads.
+    #
+    # @return [ true | false ] Whether batches are prefetched.
+    #
+    # @api private
+    def prefetch?
+      !!(view.respond_to?(:options) && view.options[:prefetch]) &&
+        (@session.nil? || @session.implicit?)
+    end
+
     # @api private
     def kill_spec
       KillSpec.new(
@@ -377,6 +405,43 @@ module Mongo
       limited? ? @remaining <= 0 : false
     end
 
+    # Returns the documents of the current batch which have not been
+    # returned yet, retrieving the next batch from the server if the
+    # current batch has been entirely returned.
+    def current_batch
+      if @documents.nil?
+        # Since published versions of Mongoid have a copy of old driver cursor
+        # code, our dup call in #process isn't invoked when Mongoid query
+        # cache is active. Work around that by also calling dup here on
+        # the result of #process which might come out of Mongoid's code.
+        @documents = process(@initial_result).dup
+        # the documents here can be an empty array, hence
+        # we may end up issuing a getMore in the first try_next call
+        maybe_prefetch
+      end
+
+      if @documents.empty?
+        # On empty batches, we cache the batch resume token
+        cache_batch_resume_token
+
+        unless closed?
+          if exhausted?
+            close
+            raise StopIteration
+          end
+          @documents = get_more
+          maybe_prefetch
+        else
+          raise StopIteration
+        end
+      else
+        # cursor is closed here
+        # keep documents as an empty array
+      end
+
+      @documents
+    end
+
     def cache_resume_token(doc)
       if doc[:_id] && doc[:_id].is_a?(Hash)
         @resume_token = doc[:_id] && doc[:_id].dup.freeze
@@ -413,6 +478,42 @@ module Mongo
       @session.end_session if @session && @session.implicit?
     end
 
+    # Starts sending the getMore for the next batch in a background thread,
+    # if prefetching is enabled and the server cursor has more documents.
+    #
+    # The getMore operation is constructed in the calling thread, so that
+    # it reflects the cursor state after the current batch was processed;
+    # its result is processed by #get_more in the calling thread.
+    def maybe_prefetch
+      return unless prefetch?
+      return if @prefetch_thread || closed? || exhausted?
+
+      op = get_more_operation
+      @prefetch_thread = Thread.new do
+        Thread.current.report_on_exception = false
+        execute_operation(op)
+      end
+    end
+
+    # Waits for an outstanding prefetch to complete and discards its
+    # documents. If the server closed the cursor when returning the
+    # prefetched batch, the cursor is marked closed so that it is not
+    # killed.
+    def discard_prefetch
+      return unless thread = @prefetch_thread
+      @prefetch_thread = nil
+
+      result = begin
+        thread.value
+      rescue Error
+        nil
+      end
+      if result && result.cursor_id == 0 && !closed?
+        unregister
+        @cursor_id = 0
+      end
+    end
+
     def limited?
       limit ? limit > 0 : false
     end
@@ -460,7 +561,15 @@ module Mongo
         session: @session,
         service_id: initial_result.connection_description.service_id,
       )
-      op.execute(@server, context: context)
+      op.execute(@server, context: context, options: execution_options)
+    end
+
+    def execution_options
+      if view.respond_to?(:options) && view.options[:raw]
+        { raw_batches: true }
+      else
+        {}
+      end
     end
   end
 end
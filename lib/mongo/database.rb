@@ -217,7 +217,8 @@ module Mongo
       selector = ServerSelector.get(txn_read_pref)
 
       client.send(:with_session, opts) do |session|
-        server = selector.select_server(cluster, nil, session)
+        context = Operation::Context.new(client: client, session: session)
+        server = select_server(cluster, selector, session, context)
         op = Operation::Command.new(
           :selector => operation.dup,
           :db_name => name,
@@ -226,7 +227,7 @@ module Mongo
         )
 
         op.execute(server,
-          context: Operation::Context.new(client: client, session: session),
+          context: context,
           options: execution_opts)
       end
     end
@@ -252,13 +253,14 @@ module Mongo
       preference = ServerSelector.get(txn_read_pref)
 
       client.send(:with_session, opts) do |session|
-        read_with_retry(session, preference) do |server|
+        context = Operation::Context.new(client: client, session: session)
+        read_with_retry(session, preference, context: context) do |server|
           Operation::Command.new({
             :selector => operation.dup,
             :db_name => name,
             :read => preference,
             :session => session
-          }).execute(server, context: Operation::Context.new(client: client, session: session))
+          }).execute(server, context: context)
         end
       end
     end
@@ -415,6 +417,10 @@ module Mongo
     #   wait on new documents to satisfy a change stream query.
     # @option options [ Integer ] :batch_size The number of documents to return per batch.
     # @option options [ BSON::Document, Hash ] :collation The collation to use.
+    # @option options [ true, false ] :prefetch Whether to send the awaited
+    #   getMore for the next batch in a background thread as soon as the
+    #   current batch is returned by the server. Only used with implicit
+    #   sessions.
     # @option options [ Session ] :session The session to use.
     # @option options [ BSON::Timestamp ] :start_at_operation_time Only return
     #   changes that occurred after the specified timestamp. Any command run
@@ -430,7 +436,7 @@ module Mongo
     # @since 2.6.0
     def watch(pipeline = [], options = {})
       Mongo::Collection::View::ChangeStream.new(
-        Mongo::Collection::View.new(collection("#{COMMAND}.aggregate")),
+        Mongo::Collection::View.new(collection("#{COMMAND}.aggregate"), {}, Utils.slice_hash(options, :prefetch)),
         pipeline,
         Mongo::Collection::View::ChangeStream::DATABASE,
         options)
@@ -228,6 +228,7 @@ require 'mongo/error/raise_original_error'
 require 'mongo/error/server_certificate_revoked'
 require 'mongo/error/socket_error'
 require 'mongo/error/socket_timeout_error'
+require 'mongo/error/timeout_error'
 require 'mongo/error/failed_string_prep_validation'
 require 'mongo/error/unchangeable_collection_option'
 require 'mongo/error/unexpected_chunk_length'
@@ -30,11 +30,16 @@ module Mongo
       #   Mongo::Error::MissingFileChunk.new(expected_n, chunk)
       #
       # @param [ Integer ] expected_n The expected index value.
-      # @param [ Grid::File::Chunk ] chunk The chunk read from GridFS.
+      # @param [ Grid::File::Chunk | nil ] chunk The chunk read from GridFS,
+      #   or nil if no more chunks were found.
       #
       # @since 2.1.0
       def initialize(expected_n, chunk)
-        super("Unexpected chunk in sequence. Expected next chunk to have index #{expected_n} but it has index #{chunk.n}")
+        if chunk
+          super("Unexpected chunk in sequence. Expected next chunk to have index #{expected_n} but it has index #{chunk.n}")
+        else
+          super("Missing chunk in sequence. Expected a chunk with index #{expected_n}")
+        end
       end
     end
   end
@@ -259,15 +259,27 @@ module Mongo
       # @example Download the file and write it to the io object.
       #   fs.download_to_stream(id, io)
       #
+      # @example Download bytes 100 through 199 of the file.
+      #   fs.download_to_stream(id, io, offset: 100, length: 100)
+      #
       # @param [ BSON::ObjectId, Object ] id The id of the file to read.
       # @param [ IO ] io The io object to write to.
+      # @param [ Hash ] opts Options for the download.
+      #
+      # @option opts [ Integer ] :offset The position in the file of the
+      #   first byte to download. Defaults to 0.
+      # @option opts [ Integer ] :length The number of bytes to download.
+      #   Defaults to the rest of the file.
+      # @option opts [ Integer ] :read_ahead The maximum number of chunk
+      #   queries to have in flight concurrently. By default chunks are
+      #   read sequentially.
       #
       # @since 2.1.0
-      def download_to_stream(id, io)
-        open_download_stream(id) do |stream|
-          stream.each do |chunk|
-            io << chunk
-          end
+      def download_to_stream(id, io, opts = {})
+        opts = Utils.shallow_symbolize_keys(opts)
+        stream_opts = Utils.slice_hash(opts, :file_info_doc, :read_ahead)
+        open_download_stream(id, stream_opts) do |stream|
+          stream.write_to(io, offset: opts[:offset] || 0, length: opts[:length])
         end
       end
 
@@ -351,13 +363,21 @@ module Mongo
       #
       # @option opts [ Integer ] :revision The revision number of the file to download.
       #   Defaults to -1, the most recent version.
+      # @option opts [ Integer ] :offset The position in the file of the
+      #   first byte to download. Defaults to 0.
+      # @option opts [ Integer ] :length The number of bytes to download.
+      #   Defaults to the rest of the file.
+      # @option opts [ Integer ] :read_ahead The maximum number of chunk
+      #   queries to have in flight concurrently.
       #
       # @raise [ Error::FileNotFound ] If the file is not found.
       # @raise [ Error::InvalidFileRevision ] If the requested revision is not found for the file.
       #
       # @since 2.1.0
       def download_to_stream_by_name(filename, io, opts = {})
-        download_to_stream(open_download_stream_by_name(filename, opts).file_id, io)
+        stream = open_download_stream_by_name(filename, opts)
+        download_to_stream(stream.file_id, io,
+          opts.merge(file_info_doc: stream.options[:file_info_doc]))
       end
 
       # Opens an upload stream to GridFS to which the contents of a file or
@@ -380,6 +400,8 @@ module Mongo
       #   option.
       # @option options [ Hash ] :write_concern The write concern options.
       #   Can be :w => Integer|String, :fsync => Boolean, :j => Boolean.
+      # @option opts [ Integer ] :max_in_flight The maximum number of chunk
+      #   batches to insert concurrently. Defaults to 1.
       #
       # @return [ Stream::Write ] The write stream.
       #
@@ -423,6 +445,8 @@ module Mongo
       #   option.
       # @option options [ Hash ] :write_concern The write concern options.
       #   Can be :w => Integer|String, :fsync => Boolean, :j => Boolean.
+      # @option opts [ Integer ] :max_in_flight The maximum number of chunk
+      #   batches to insert concurrently. Defaults to 1.
       #
       # @return [ BSON::ObjectId ] The ObjectId file id.
       #
@@ -26,6 +26,12 @@ module Mongo
         class Read
           include Enumerable
 
+          # The number of chunks requested by each query issued when
+          # reading ahead.
+          #
+          # @api private
+          READ_AHEAD_SEGMENT_SIZE = 16
+
           # @return [ FSBucket ] fs The fs bucket from which this stream reads.
           #
           # @since 2.1.0
@@ -51,6 +57,10 @@ module Mongo
           #
           # @option options [ BSON::Document ] :file_info_doc For internal
           #   driver use only. A BSON document to use as file information.
+          # @option options [ Integer ] :read_ahead The maximum number of
+          #   chunk queries that #write_to may have in flight concurrently,
+          #   each fetching up to READ_AHEAD_SEGMENT_SIZE chunks. By default
+          #   chunks are read sequentially through a single cursor.
           #
           # @since 2.1.0
           def initialize(fs, options)
@@ -103,7 +113,73 @@ module Mongo
           #
           # @since 2.1.0
           def read
-            to_a.join
+            io = StringIO.new(String.new(encoding: BSON::BINARY))
+            write_to(io)
+            io.string
+          end
+
+          # Write the file data, or the requested byte range of it, to the
+          # provided io object.
+          #
+          # Only the chunks that cover the requested range are queried, and
+          # their data is written to the io object as it is received. When
+          # the stream was created with the :read_ahead option and no
+          # explicit session, the chunks are fetched by up to that many
+          # concurrent queries, bounding the amount of data held in memory
+          # to read_ahead * READ_AHEAD_SEGMENT_SIZE chunks.
+          #
+          # @example Write bytes 100 through 199 of the file to an io object.
+          #   stream.write_to(io, offset: 100, length: 100)
+          #
+          # @param [ IO ] io The io object to write to.
+          # @param [ Integer ] offset The position in the file of the first
+          #   byte to write.
+          # @param [ Integer | nil ] length The number of bytes to write. If
+          #   omitted, or if the range extends past the end of the file, the
+          #   data through the end of the file is written.
+          #
+          # @return [ Integer ] The number of bytes written.
+          #
+          # @raise [ ArgumentError ] If the range is not within the file.
+          # @raise [ Error::MissingFileChunk ] If a chunk is found out of sequence.
+          # @raise [ Error::ExtraFileChunk ] If the range extends to the end
+          #   of the file and the file has more chunks than its length requires.
+          #
+          # @since 2.16.0
+          def write_to(io, offset: 0, length: nil)
+            ensure_readable!
+            info = file_info
+            if offset < 0 || offset > info.length
+              raise ArgumentError, "Offset must be between 0 and the file length (#{info.length}): #{offset}"
+            end
+            if length && length < 0
+              raise ArgumentError, "Length must be non-negative: #{length}"
+            end
+            remaining = info.length - offset
+            remaining = length if length && length < remaining
+            return 0 if remaining == 0
+
+            num_chunks = (info.length + info.chunk_size - 1) / info.chunk_size
+            first_n = offset / info.chunk_size
+            last_n = (offset + remaining - 1) / info.chunk_size
+            skip = offset - first_n * info.chunk_size
+            written = 0
+            each_chunk_in(first_n, last_n) do |chunk|
+              validate_length!(chunk.n, num_chunks, chunk, chunk.n * info.chunk_size)
+              data = chunk.data.data
+              if skip > 0 || data.bytesize - skip > remaining - written
+                data = data.byteslice(skip, remaining - written)
+                skip = 0
+              end
+              io << data
+              written += data.bytesize
+            end
+            if last_n == num_chunks - 1
+              # Chunks past the end of the file are not covered by the
+              # range query.
+              validate_no_extra_chunks!(last_n)
+            end
+            written
           end
 
           # Close the read stream.
@@ -197,14 +273,81 @@ module Mongo
           end
 
           def view
-            @view ||= begin
-              opts = if read_preference
-                options.merge(read: read_preference)
-              else
-                options
+            @view ||= fs.chunks_collection.find({ :files_id => file_id }, view_options).sort(:n => 1)
+          end
+
+          def view_options
+            if read_preference
+              options.merge(read: read_preference)
+            else
+              options
+            end
+          end
+
+          def chunks_view(first_n, last_n)
+            fs.chunks_collection.find(
+              { :files_id => file_id, :n => { '$gte' => first_n, '$lte' => last_n } },
+              view_options
+            ).sort(:n => 1)
+          end
+
+          def read_ahead?
+            options[:read_ahead] && options[:read_ahead] > 1 && !options[:session]
+          end
+
+          # Yields the chunks numbered first_n through last_n in order,
+          # raising MissingFileChunk if any of them does not exist.
+          def each_chunk_in(first_n, last_n)
+            expected_n = first_n
+            if read_ahead?
+              each_segment_read_ahead(first_n, last_n) do |docs|
+                docs.each do |doc|
+                  chunk = Grid::File::Chunk.new(doc)
+                  validate_n!(expected_n, chunk)
+                  yield chunk
+                  expected_n += 1
+                end
+              end
+            else
+              chunks_view(first_n, last_n).each do |doc|
+                chunk = Grid::File::Chunk.new(doc)
+                validate_n!(expected_n, chunk)
+                yield chunk
+                expected_n += 1
               end
+            end
+            if expected_n <= last_n
+              close
+              raise Error::MissingFileChunk.new(expected_n, nil)
+            end
+          end
 
-              fs.chunks_collection.find({ :files_id => file_id }, opts).sort(:n => 1)
+          # Fetches the chunks in segments of READ_AHEAD_SEGMENT_SIZE chunks,
+          # keeping up to options[:read_ahead] segment queries in flight,
+          # and yields the documents of each segment in order.
+          def each_segment_read_ahead(first_n, last_n)
+            segments = first_n.step(last_n, READ_AHEAD_SEGMENT_SIZE).map do |n|
+              [n, [n + READ_AHEAD_SEGMENT_SIZE - 1, last_n].min]
+            end
+            in_flight = []
+            begin
+              until segments.empty? && in_flight.empty?
+                while in_flight.length < options[:read_ahead] && !segments.empty?
+                  segment = segments.shift
+                  in_flight << Thread.new do
+                    Thread.current.report_on_exception = false
+                    chunks_view(*segment).to_a
+                  end
+                end
+                yield in_flight.shift.value
+              end
+            ensure
+              in_flight.each do |thread|
+                begin
+                  thread.join
+                rescue StandardError
+                end
+              end
             end
           end
 
@@ -231,6 +374,20 @@ module Mongo
             end
           end
 
+          # Raises ExtraFileChunk if a non-empty chunk numbered after the
+          # last chunk of the file exists.
+          def validate_no_extra_chunks!(last_n)
+            fs.chunks_collection.find(
+              { :files_id => file_id, :n => { '$gt' => last_n } },
+              view_options
+            ).sort(:n => 1).each do |doc|
+              if Grid::File::Chunk.new(doc).data.data.size > 0
+                close
+                raise Error::ExtraFileChunk.new
+              end
+            end
+          end
+
           def validate_n!(index, chunk)
             unless index == chunk.n
               close
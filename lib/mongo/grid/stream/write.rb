@@ -25,6 +25,12 @@ module Mongo
         # @since 2.1.0
         class Write
 
+          # The number of data bytes after which the chunks read from the
+          # source are inserted into the chunks collection.
+          #
+          # @api private
+          INSERT_BATCH_BYTES = 8 * 1024 * 1024
+
           # @return [ FSBucket ] fs The fs bucket to which this stream writes.
           #
           # @since 2.1.0
@@ -65,6 +71,10 @@ module Mongo
           #   option.
           # @option options [ Hash ] :write_concern The write concern options.
           #   Can be :w => Integer|String, :fsync => Boolean, :j => Boolean.
+          # @option options [ Integer ] :max_in_flight The maximum number of
+          #   chunk batches that may be inserted concurrently while further
+          #   data is read from the source. Defaults to 1, inserting each
+          #   batch before reading the next one.
           #
           # @since 2.1.0
           def initialize(fs, options)
@@ -73,6 +83,10 @@ module Mongo
             @n = 0
             @file_id = options[:file_id] || BSON::ObjectId.new
             @options = options.dup
+            @max_in_flight = @options.delete(:max_in_flight) || 1
+            if @max_in_flight < 1
+              raise ArgumentError, "Max in flight must be positive: #{@max_in_flight}"
+            end
 =begin WriteConcern object support
             if @options[:write_concern].is_a?(WriteConcern::Base)
               # Cache the instance so that we do not needlessly reconstruct it.
@@ -87,6 +101,14 @@ module Mongo
 
           # Write to the GridFS bucket from the source stream or a string.
           #
+          # The source is read in chunk size blocks, which are inserted into
+          # the chunks collection in batches of about INSERT_BATCH_BYTES, so
+          # that the memory used does not depend on the size of the source.
+          # When the stream was created with a :max_in_flight option greater
+          # than 1 and no explicit session, up to that many batches are
+          # inserted concurrently. All batches have been inserted when this
+          # method returns.
+          #
           # @example Write to GridFS.
           #   stream.write(io)
           #
@@ -98,16 +120,37 @@ module Mongo
           def write(io)
             ensure_open!
             @indexes ||= ensure_indexes!
-            @length += if io.respond_to?(:bytesize)
-              # String objects
-              io.bytesize
-            else
-              # IO objects
-              io.size
+            io = StringIO.new(io) if io.is_a?(String)
+            collection = chunks_collection
+            in_flight = []
+            begin
+              batch = []
+              batch_bytes = 0
+              while bytes = io.read(file_info.chunk_size)
+                break if bytes.empty?
+                file_info.update_md5(bytes)
+                batch << File::Chunk.new(
+                  data: BSON::Binary.new(bytes),
+                  files_id: file_id,
+                  n: @n + batch.length,
+                )
+                batch_bytes += bytes.bytesize
+                if batch_bytes >= INSERT_BATCH_BYTES
+                  insert_chunks(collection, batch, batch_bytes, in_flight)
+                  batch = []
+                  batch_bytes = 0
+                end
+              end
+              insert_chunks(collection, batch, batch_bytes, in_flight) unless batch.empty?
+              in_flight.shift.value until in_flight.empty?
+            ensure
+              in_flight.each do |thread|
+                begin
+                  thread.join
+                rescue StandardError
+                end
+              end
             end
-            chunks = File::Chunk.split(io, file_info, @n)
-            @n += chunks.size
-            chunks_collection.insert_many(chunks) unless chunks.empty?
             self
           end
 
@@ -190,6 +233,27 @@ module Mongo
             end
           end
 
+          # Inserts a batch of chunks, in a background thread when
+          # concurrent inserts are enabled, waiting for the oldest batch in
+          # flight to be inserted first if the limit has been reached.
+          #
+          # The stream position and length are advanced as soon as the
+          # batch is handed off; if an insert fails, the error is raised
+          # from #write and the upload should be aborted.
+          def insert_chunks(collection, batch, batch_bytes, in_flight)
+            @n += batch.length
+            @length += batch_bytes
+            if @max_in_flight > 1 && !options[:session]
+              in_flight.shift.value while in_flight.length >= @max_in_flight
+              in_flight << Thread.new do
+                Thread.current.report_on_exception = false
+                collection.insert_many(batch)
+              end
+            else
+              collection.insert_many(batch)
+            end
+          end
+
           def update_length
             file_info.document[:length] = @length
           end
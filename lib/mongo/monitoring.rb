@@ -214,11 +214,18 @@ module Mongo
     #   succeed for all event types, but subscribers to SDAM events will
     #   not be invoked. Values other than false result in default behavior
     #   which is to perform normal SDAM event publication.
+    # @option options [ true, false ] :metrics Whether to collect command
+    #   and connection pool metrics.
+    # @option options [ Float ] :metrics_sample_rate The fraction of
+    #   latencies to record in metrics histograms.
     #
     # @since 2.1.0
     # @api private
     def initialize(options = {})
       @options = options
+      if options[:metrics]
+        @metrics = Metrics.new(sample_rate: options[:metrics_sample_rate])
+      end
       if options[:monitoring] != false
         Global.subscribers.each do |topic, subscribers|
           subscribers.each do |subscriber|
@@ -241,6 +248,12 @@ module Mongo
     # @api private
     attr_reader :options
 
+    # @return [ Metrics | nil ] The metrics collected for the client, if
+    #   metrics collection is enabled.
+    #
+    # @api private
+    attr_reader :metrics
+
     # @api private
     def monitoring?
       options[:monitoring] != false
@@ -366,6 +379,7 @@ module Mongo
 end
 
 require 'mongo/monitoring/event'
+require 'mongo/monitoring/metrics'
 require 'mongo/monitoring/publishable'
 require 'mongo/monitoring/command_log_subscriber'
 require 'mongo/monitoring/cmap_log_subscriber'
@@ -0,0 +1,294 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  class Monitoring
+
+    # Collects command latency histograms and connection pool metrics in
+    # process.
+    #
+    # Unlike event subscribers, metrics do not require an event object to be
+    # created for each operation: the driver records durations and counts
+    # directly into preallocated histograms. The collected values are
+    # retrieved by calling #snapshot or #to_prometheus, for example from the
+    # request handler of a metrics exporter.
+    #
+    # Latency observations may be sampled by specifying a sample rate below
+    # 1. Histograms then contain only the sampled observations, while
+    # counters and gauges are always exact.
+    #
+    # @example Enable metrics and export them.
+    #   client = Mongo::Client.new(['localhost'], metrics: true)
+    #   client.metrics.to_prometheus
+    #
+    # @since 2.16.0
+    class Metrics
+
+      # Default upper bounds, in seconds, of the histogram buckets.
+      DEFAULT_BUCKETS = [
+        0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+        0.1, 0.25, 0.5, 1, 2.5, 5, 10,
+      ].freeze
+
+      # A histogram with fixed buckets.
+      #
+      # @api private
+      class Histogram
+
+        # @param [ Array<Numeric> ] bounds The sorted upper bounds of the
+        #   buckets, excluding the implicit +Inf bucket.
+        def initialize(bounds)
+          @bounds = bounds
+          @counts = Array.new(bounds.length + 1, 0)
+          @sum = 0.0
+          @count = 0
+        end
+
+        attr_reader :sum, :count
+
+        # @param [ Numeric ] value The value to record.
+        def observe(value)
+          index = @bounds.bsearch_index { |bound| bound >= value } || @bounds.length
+          @counts[index] += 1
+          @sum += value
+          @count += 1
+        end
+
+        # @return [ Hash ] The histogram, with :buckets mapping each upper
+        #   bound to the cumulative number of observations at or below it.
+        def to_h
+          cumulative = 0
+          buckets = {}
+          @bounds.each_with_index do |bound, index|
+            cumulative += @counts[index]
+            buckets[bound] = cumulative
+          end
+          buckets[Float::INFINITY] = @count
+          { count: @count, sum: @sum, buckets: buckets }
+        end
+      end
+
+      # Create the metrics.
+      #
+      # @param [ Hash ] options The options.
+      #
+      # @option options [ Float ] :sample_rate The fraction of latencies to
+      #   record in histograms, greater than 0 and at most 1. Defaults to 1.
+      # @option options [ Array<Numeric> ] :buckets The upper bounds of the
+      #   histogram buckets, in seconds.
+      #
+      # @raise [ ArgumentError ] If the sample rate is out of range.
+      def initialize(options = {})
+        @sample_rate = options[:sample_rate] || 1
+        unless @sample_rate > 0 && @sample_rate <= 1
+          raise ArgumentError, "Metrics sample rate must be greater than 0 and at most 1: #{@sample_rate}"
+        end
+        @buckets = (options[:buckets] || DEFAULT_BUCKETS).sort.freeze
+        @lock = Mutex.new
+        reset
+      end
+
+      # @return [ Float ] The fraction of latencies recorded in histograms.
+      attr_reader :sample_rate
+
+      # @return [ Array<Numeric> ] The upper bounds of the histogram buckets.
+      attr_reader :buckets
+
+      # Records the completion of a command.
+      #
+      # @param [ String ] command_name The name of the command.
+      # @param [ Address ] address The address of the server.
+      # @param [ Float ] duration The duration of the command in seconds.
+      # @param [ true | false ] succeeded Whether the command succeeded.
+      #
+      # @api private
+      def record_command(command_name, address, duration, succeeded)
+        sampled = sampled?
+        @lock.synchronize do
+          if sampled
+            servers = @command_durations[command_name] ||= {}
+            (servers[address.seed] ||= Histogram.new(@buckets)).observe(duration)
+          end
+          unless succeeded
+            servers = @command_failures[command_name] ||= {}
+            servers[address.seed] = (servers[address.seed] || 0) + 1
+          end
+        end
+      end
+
+      # Records a connection check out.
+      #
+      # @param [ Address ] address The address of the server.
+      # @param [ Float ] duration The time spent checking out, in seconds.
+      #
+      # @api private
+      def record_check_out(address, duration)
+        sampled = sampled?
+        @lock.synchronize do
+          pool = pool_metrics(address)
+          pool[:checked_out] += 1
+          pool[:check_out_duration].observe(duration) if sampled
+        end
+      end
+
+      # Records a connection check in.
+      #
+      # @param [ Address ] address The address of the server.
+      #
+      # @api private
+      def record_check_in(address)
+        @lock.synchronize do
+          pool_metrics(address)[:checked_out] -= 1
+        end
+      end
+
+      # Records the establishment of a connection for a pool.
+      #
+      # @param [ Address ] address The address of the server.
+      # @param [ Float ] duration The time spent connecting, including the
+      #   handshake and authentication, in seconds.
+      #
+      # @api private
+      def record_connection_created(address, duration)
+        sampled = sampled?
+        @lock.synchronize do
+          pool = pool_metrics(address)
+          pool[:connections_created] += 1
+          pool[:connection_creation_duration].observe(duration) if sampled
+        end
+      end
+
+      # Returns the collected metrics.
+      #
+      # @example Get the number of find commands sent to a server.
+      #   metrics.snapshot[:commands]['find']['localhost:27017'][:count]
+      #
+      # @return [ Hash ] The metrics, with the following keys:
+      #   - *:commands* -- a hash from command name to a hash from server
+      #     address to the duration histogram of the command, which also
+      #     has the number of failed commands under :failures.
+      #   - *:pools* -- a hash from server address to the pool metrics:
+      #     :checked_out, :connections_created, and the :check_out_duration
+      #     and :connection_creation_duration histograms.
+      #   - *:sample_rate* -- the fraction of latencies recorded.
+      #
+      #   Each histogram is a hash with :count, :sum and :buckets, the
+      #   latter mapping bucket upper bounds to cumulative counts.
+      def snapshot
+        @lock.synchronize do
+          commands = {}
+          (@command_durations.keys | @command_failures.keys).each do |command_name|
+            durations = @command_durations[command_name] || {}
+            failures = @command_failures[command_name] || {}
+            commands[command_name] = {}
+            (durations.keys | failures.keys).each do |server|
+              histogram = (durations[server] || Histogram.new(@buckets)).to_h
+              commands[command_name][server] = histogram.merge(failures: failures[server] || 0)
+            end
+          end
+          pools = {}
+          @pools.each do |server, pool|
+            pools[server] = {
+              checked_out: pool[:checked_out],
+              connections_created: pool[:connections_created],
+              check_out_duration: pool[:check_out_duration].to_h,
+              connection_creation_duration: pool[:connection_creation_duration].to_h,
+            }
+          end
+          { commands: commands, pools: pools, sample_rate: @sample_rate }
+        end
+      end
+
+      # Returns the collected metrics in the Prometheus text exposition
+      # format.
+      #
+      # @return [ String ] The metrics.
+      def to_prometheus
+        data = snapshot
+        lines = []
+
+        lines << '# TYPE mongo_command_duration_seconds histogram'
+        data[:commands].each do |command_name, servers|
+          servers.each do |server, histogram|
+            labels = %(command="#{command_name}",server="#{server}")
+            prometheus_histogram(lines, 'mongo_command_duration_seconds', labels, histogram)
+          end
+        end
+        lines << '# TYPE mongo_command_failures_total counter'
+        data[:commands].each do |command_name, servers|
+          servers.each do |server, histogram|
+            lines << %(mongo_command_failures_total{command="#{command_name}",server="#{server}"} #{histogram[:failures]})
+          end
+        end
+
+        lines << '# TYPE mongo_pool_checked_out_connections gauge'
+        data[:pools].each do |server, pool|
+          lines << %(mongo_pool_checked_out_connections{server="#{server}"} #{pool[:checked_out]})
+        end
+        lines << '# TYPE mongo_pool_connections_created_total counter'
+        data[:pools].each do |server, pool|
+          lines << %(mongo_pool_connections_created_total{server="#{server}"} #{pool[:connections_created]})
+        end
+        lines << '# TYPE mongo_pool_check_out_duration_seconds histogram'
+        data[:pools].each do |server, pool|
+          prometheus_histogram(lines, 'mongo_pool_check_out_duration_seconds',
+            %(server="#{server}"), pool[:check_out_duration])
+        end
+        lines << '# TYPE mongo_pool_connection_creation_duration_seconds histogram'
+        data[:pools].each do |server, pool|
+          prometheus_histogram(lines, 'mongo_pool_connection_creation_duration_seconds',
+            %(server="#{server}"), pool[:connection_creation_duration])
+        end
+
+        lines.join("\n") + "\n"
+      end
+
+      # Discards all collected metrics.
+      def reset
+        @lock.synchronize do
+          @command_durations = {}
+          @command_failures = {}
+          @pools = {}
+        end
+      end
+
+      private
+
+      def sampled?
+        @sample_rate >= 1 || rand < @sample_rate
+      end
+
+      def pool_metrics(address)
+        @pools[address.seed] ||= {
+          checked_out: 0,
+          connections_created: 0,
+          check_out_duration: Histogram.new(@buckets),
+          connection_creation_duration: Histogram.new(@buckets),
+        }
+      end
+
+      def prometheus_histogram(lines, name, labels, histogram)
+        histogram[:buckets].each do |bound, count|
+          le = bound == Float::INFINITY ? '+Inf' : bound.to_s
+          lines << %(#{name}_bucket{#{labels},le="#{le}"} #{count})
+        end
+        lines << %(#{name}_sum{#{labels}} #{histogram[:sum]})
+        lines << %(#{name}_count{#{labels}} #{histogram[:count]})
+      end
+    end
+  end
+end
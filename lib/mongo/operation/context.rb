@@ -33,9 +33,18 @@ module Mongo
     # operation execution, context objects should not be reused for multiple
     # operations.
     #
+    # When the :timeout_ms client option is set, the context also holds the
+    # deadline by which the operation, including server selection,
+    # connection check out, retries and reading the reply, must complete.
+    # The deadline is computed when the context is created, which must
+    # therefore happen before the server for the operation is selected.
+    #
     # @api private
     class Context
-      def initialize(client: nil, session: nil, service_id: nil, options: nil)
+      # @param [ Integer | nil ] timeout_ms The time, in milliseconds, in
+      #   which the operation must complete. Defaults to the :timeout_ms
+      #   client option; zero means no timeout.
+      def initialize(client: nil, session: nil, service_id: nil, options: nil, timeout_ms: nil)
         if options
           if client
             raise ArgumentError, 'Client and options cannot both be specified'
@@ -54,12 +63,63 @@ module Mongo
         @session = session
         @service_id = service_id
         @options = options
+
+        timeout_ms ||= client && client.options[:timeout_ms]
+        if timeout_ms && timeout_ms > 0
+          @deadline = Utils.monotonic_time + timeout_ms / 1000.0
+        end
       end
 
       attr_reader :client
       attr_reader :session
       attr_reader :options
 
+      # @return [ Float | nil ] The monotonic time by which the operation
+      #   must complete, or nil if the operation has no timeout.
+      attr_reader :deadline
+
+      # Whether the operation has a timeout.
+      #
+      # @return [ true | false ] Whether the operation has a timeout.
+      def timeout?
+        !@deadline.nil?
+      end
+
+      # Returns the time remaining until the deadline of the operation.
+      #
+      # @return [ Float | nil ] The remaining time, in seconds, or nil if the
+      #   operation has no timeout.
+      #
+      # @raise [ Error::TimeoutError ] If the deadline has passed.
+      def remaining_timeout_sec
+        return nil unless @deadline
+
+        remaining = @deadline - Utils.monotonic_time
+        if remaining <= 0
+          raise Error::TimeoutError, 'The operation did not complete within the timeout_ms limit'
+        end
+        remaining
+      end
+
+      # Whether the deadline of the operation has passed.
+      #
+      # @return [ true | false ] Whether the deadline has passed.
+      def deadline_expired?
+        !@deadline.nil? && Utils.monotonic_time >= @deadline
+      end
+
+      # Returns a context for the same operation, with the same deadline,
+      # using the specified session.
+      #
+      # @param [ Session | nil ] session The session.
+      #
+      # @return [ Context ] The new context.
+      def with_session(session)
+        dup.tap do |context|
+          context.session = session
+        end
+      end
+
       def service_id
         @service_id || session&.pinned_service_id
       end
@@ -115,6 +175,10 @@ module Mongo
           raise Error::InternalDriverError, 'Encrypter should only be accessed when encryption is to be performed'
         end
       end
+
+      protected
+
+      attr_writer :session
     end
   end
 end
@@ -26,7 +26,10 @@ module Mongo
         module Command
 
           # The mappings from ruby options to the find command.
-          OPTION_MAPPINGS = BSON::Document.new(
+          #
+          # The keys are symbols, like those of operation specs, so that the
+          # spec can be read without being converted to a BSON::Document.
+          OPTION_MAPPINGS = {
             allow_disk_use: 'allowDiskUse',
             allow_partial_results: 'allowPartialResults',
             await_data: 'awaitData',
@@ -52,7 +55,7 @@ module Mongo
             sort: 'sort',
             tailable: 'tailable',
             tailable_cursor: 'tailable',
-          ).freeze
+          }.freeze
 
           module_function def selector(spec, connection)
             if spec[:collation] && !connection.features.collation_enabled?
@@ -32,9 +32,6 @@ module Mongo
         private
 
         def selector(connection)
-          # The mappings are BSON::Documents and as such store keys as
-          # strings, the spec here has symbol keys.
-          spec = BSON::Document.new(self.spec)
           {
             find: coll_name,
             Protocol::Msg::DATABASE_IDENTIFIER => db_name,
@@ -89,9 +89,26 @@ module Mongo
         if server_api = context.server_api
           msg = msg.maybe_add_server_api(server_api)
         end
+        if context.timeout?
+          msg = msg.maybe_add_max_time_ms(max_time_ms(connection, context))
+        end
         msg
       end
 
+      # Returns the maxTimeMS for an operation with a timeout: the time
+      # remaining until its deadline, less the minimum round trip time to
+      # the server, which the reply takes to arrive.
+      #
+      # @raise [ Error::TimeoutError ] If the remaining time is shorter than
+      #   the round trip time.
+      def max_time_ms(connection, context)
+        remaining = context.remaining_timeout_sec - (connection.server.min_round_trip_time || 0)
+        if remaining <= 0
+          raise Error::TimeoutError, 'The time remaining until the timeout_ms deadline is shorter than the round trip time to the server'
+        end
+        (remaining * 1000).ceil
+      end
+
       def process_result(result, connection)
         connection.server.update_cluster_time(result)
 
@@ -241,8 +241,8 @@ module Mongo
         super.tap do |message|
           if session = context.session
             # Serialize the message to detect client-side problems,
-            # such as invalid BSON keys. The message will be serialized again
-            # later prior to being sent to the connection.
+            # such as invalid BSON keys. The message keeps the serialized
+            # sections and reuses them when it is sent to the connection.
             message.serialize(BSON::ByteBuffer.new)
 
             session.update_state!
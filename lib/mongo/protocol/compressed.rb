@@ -74,33 +74,61 @@ module Mongo
       # @param [ String, Symbol ] compressor The compression algorithm to use.
       # @param [ Integer ] zlib_compression_level The zlib compression level to use.
       #   -1 and nil imply default.
+      # @param [ Integer ] zstd_compression_level The zstd compression level
+      #   to use. nil implies default.
       #
       # @since 2.5.0
-      def initialize(message, compressor, zlib_compression_level = nil)
+      def initialize(message, compressor, zlib_compression_level = nil, zstd_compression_level = nil)
         @original_message = message
         @original_op_code = message.op_code
         @uncompressed_size = 0
         @compressor_id = COMPRESSOR_ID_MAP[compressor]
         @compressed_message = ''
         @zlib_compression_level = zlib_compression_level if zlib_compression_level && zlib_compression_level != -1
+        @zstd_compression_level = zstd_compression_level
         @request_id = message.request_id
       end
 
+      # Serializes the compressed message using the already serialized
+      # original message, rather than serializing the original message again.
+      #
+      # @param [ BSON::ByteBuffer ] serialized_original The original message,
+      #   serialized with its header, as produced by Message#serialize.
+      # @param [ BSON::ByteBuffer ] buffer Buffer to receive the compressed
+      #   message.
+      #
+      # @return [ BSON::ByteBuffer ] buffer containing the serialized message.
+      #
+      # @api private
+      def serialize_from(serialized_original, buffer = BSON::ByteBuffer.new)
+        bytes = serialized_original.to_s
+        # Slicing to the end of the string shares the string's memory
+        # rather than copying it.
+        @original_fields = bytes.byteslice(Header::SIZE, bytes.bytesize - Header::SIZE)
+        begin
+          serialize(buffer)
+        ensure
+          @original_fields = nil
+        end
+      end
+
       # Inflates an OP_COMRESSED message and returns the original message.
       #
+      # @param [ Hash ] options The deserialization options.
+      #
       # @return [ Protocol::Message ] The inflated message.
       #
       # @since 2.5.0
       # @api private
-      def maybe_inflate
+      def maybe_inflate(options = {})
         message = Registry.get(@original_op_code).allocate
         buf = decompress(@compressed_message)
 
         message.send(:fields).each do |field|
           if field[:multi]
-            Message.deserialize_array(message, buf, field)
+            Message.deserialize_array(message, buf, field, options)
           else
-            Message.deserialize_field(message, buf, field)
+            Message.deserialize_field(message, buf, field, options)
           end
         end
         if message.is_a?(Msg)
@@ -146,23 +174,31 @@ module Mongo
       field :compressed_message, Bytes
 
       def serialize_fields(buffer, max_bson_size)
-        buf = BSON::ByteBuffer.new
-        @original_message.send(:serialize_fields, buf, max_bson_size)
-        @uncompressed_size = buf.length
-        @compressed_message = compress(buf)
+        if @original_fields
+          bytes = @original_fields
+        else
+          buf = BSON::ByteBuffer.new
+          @original_message.send(:serialize_fields, buf, max_bson_size)
+          bytes = buf.to_s
+        end
+        @uncompressed_size = bytes.bytesize
+        @compressed_message = compress(bytes)
         super
       end
 
-      def compress(buffer)
+      def compress(bytes)
         if @compressor_id == NOOP_BYTE
-          buffer.to_s.force_encoding(BSON::BINARY)
+          bytes.dup.force_encoding(BSON::BINARY)
         elsif @compressor_id == ZLIB_BYTE
-          Zlib::Deflate.deflate(buffer.to_s, @zlib_compression_level).force_encoding(BSON::BINARY)
+          Zlib::Deflate.deflate(bytes, @zlib_compression_level).force_encoding(BSON::BINARY)
         elsif @compressor_id == SNAPPY_BYTE
-          Snappy.deflate(buffer.to_s).force_encoding(BSON::BINARY)
+          Snappy.deflate(bytes).force_encoding(BSON::BINARY)
         elsif @compressor_id == ZSTD_BYTE
-          # DRIVERS-600 will allow this to be configurable in the future
-          Zstd.compress(buffer.to_s).force_encoding(BSON::BINARY)
+          if @zstd_compression_level
+            Zstd.compress(bytes, @zstd_compression_level).force_encoding(BSON::BINARY)
+          else
+            Zstd.compress(bytes).force_encoding(BSON::BINARY)
+          end
         end
       end
 
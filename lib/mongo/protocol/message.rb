@@ -98,18 +98,28 @@ module Mongo
         false
       end
 
+      # Get the name of the command the message sends.
+      #
+      # @return [ String ] The command name.
+      #
+      # @api private
+      def command_name
+        payload[:command_name]
+      end
+
       # Compress the message, if supported by the wire protocol used and if
       # the command being sent permits compression. Otherwise returns self.
       #
       # @param [ String, Symbol ] compressor The compressor to use.
       # @param [ Integer ] zlib_compression_level The zlib compression level to use.
+      # @param [ Integer ] zstd_compression_level The zstd compression level to use.
       #
       # @return [ self ] Always returns self. Other message types should
       #   override this method.
       #
       # @since 2.5.0
       # @api private
-      def maybe_compress(compressor, zlib_compression_level = nil)
+      def maybe_compress(compressor, zlib_compression_level = nil, zstd_compression_level = nil)
         self
       end
 
@@ -119,14 +129,15 @@ module Mongo
       # @param [ String ] command_name Command name extracted from the message.
       # @param [ String | Symbol ] compressor The compressor to use.
       # @param [ Integer ] zlib_compression_level Zlib compression level to use.
+      # @param [ Integer ] zstd_compression_level Zstd compression level to use.
       #
       # @return [ Message ] A Protocol::Compressed message or self,
       #  depending on whether this message can be compressed.
       #
       # @since 2.5.0
-      private def compress_if_possible(command_name, compressor, zlib_compression_level)
+      private def compress_if_possible(command_name, compressor, zlib_compression_level, zstd_compression_level = nil)
         if compressor && compression_allowed?(command_name)
-          Compressed.new(self, compressor, zlib_compression_level)
+          Compressed.new(self, compressor, zlib_compression_level, zstd_compression_level)
         else
           self
         end
@@ -134,12 +145,14 @@ module Mongo
 
       # Inflate a message if it is compressed.
       #
+      # @param [ Hash ] options The deserialization options.
+      #
       # @return [ Protocol::Message ] Always returns self. Subclasses should
       #   override this method as necessary.
       #
       # @since 2.5.0
       # @api private
-      def maybe_inflate
+      def maybe_inflate(options = {})
         self
       end
 
@@ -170,6 +183,18 @@ module Mongo
         self
       end
 
+      # Adds maxTimeMS to the command, unless it has a smaller maxTimeMS.
+      #
+      # Messages other than OP_MSG are only sent to servers older than 3.6,
+      # to which maxTimeMS is not added.
+      #
+      # @param [ Integer ] max_time_ms The maxTimeMS value.
+      #
+      # @return [ Message ] The message.
+      def maybe_add_max_time_ms(max_time_ms)
+        self
+      end
+
       def maybe_add_server_api(server_api)
         raise Error::ServerApiNotSupported, "Server API parameters cannot be sent to pre-3.6 MongoDB servers. Please remove the :server_api parameter from Client options or use MongoDB 3.6 or newer"
       end
@@ -199,14 +224,7 @@ module Mongo
       # @param buffer [String] buffer where the message should be inserted
       # @return [String] buffer containing the serialized message
       def serialize(buffer = BSON::ByteBuffer.new, max_bson_size = nil, bson_overhead = nil)
-        max_size =
-          if max_bson_size && bson_overhead
-            max_bson_size + bson_overhead
-          elsif max_bson_size
-            max_bson_size
-          else
-            nil
-          end
+        max_size = max_serialized_size(max_bson_size, bson_overhead)
 
         start = buffer.length
         serialize_header(buffer)
@@ -216,6 +234,26 @@ module Mongo
 
       alias_method :to_s, :serialize
 
+      # Serializes message into a list of buffers which, when written to the
+      # wire in order, produce the same bytes as #serialize.
+      #
+      # This permits writing large messages to the socket one segment at a
+      # time, without ever concatenating the entire message into a single
+      # buffer. By default the message is serialized into a single segment;
+      # message types that consist of independently serializable parts
+      # override this method.
+      #
+      # @param [ Integer ] max_bson_size The maximum bson object size.
+      # @param [ Integer ] bson_overhead The additional allowance for
+      #   command data.
+      #
+      # @return [ Array<String> ] The serialized segments.
+      #
+      # @api private
+      def serialize_segments(max_bson_size = nil, bson_overhead = nil)
+        [serialize(BSON::ByteBuffer.new, max_bson_size, bson_overhead).to_s]
+      end
+
       # Deserializes messages from an IO stream.
       #
       # This method returns decompressed messages (i.e. if the message on the
@@ -231,6 +269,9 @@ module Mongo
       #   possible.
       # @option options [ Numeric ] :socket_timeout The timeout to use for
       #   each read operation.
+      # @option options [ Float ] :deadline The monotonic time by which the
+      #   operation the message is the reply to must complete. Each read
+      #   is limited to the time remaining until the deadline.
       #
       # @return [ Message ] Instance of a Message class
       #
@@ -244,11 +285,7 @@ module Mongo
         # timeout option. For compatibility with whoever might call this
         # method with some other IO-like object, pass options only when they
         # are not empty.
-        read_options = {}
-        if timeout = options[:socket_timeout]
-          read_options[:timeout] = timeout
-        end
-
+        read_options = io_read_options(io, options)
         if read_options.empty?
           chunk = io.read(16)
         else
@@ -269,6 +306,7 @@ module Mongo
           raise Error::UnexpectedResponse.new(expected_response_to, response_to)
         end
 
+        read_options = io_read_options(io, options) if options[:deadline]
         if read_options.empty?
           chunk = io.read(length - 16)
         else
@@ -287,8 +325,25 @@ module Mongo
         if message.is_a?(Msg)
           message.fix_after_deserialization
         end
-        message.maybe_inflate
+        message.maybe_inflate(options)
+      end
+
+      # Returns the options for reading a message from io.
+      #
+      # @raise [ Error::TimeoutError ] If the deadline has passed.
+      def self.io_read_options(io, options)
+        timeout = options[:socket_timeout]
+        if deadline = options[:deadline]
+          remaining = deadline - Utils.monotonic_time
+          if remaining <= 0
+            raise Error::TimeoutError, 'The operation did not complete within the timeout_ms limit'
+          end
+          timeout ||= io.timeout if io.respond_to?(:timeout)
+          timeout = remaining if timeout.nil? || remaining < timeout
+        end
+        timeout ? { timeout: timeout } : {}
       end
+      private_class_method :io_read_options
 
       # Tests for equality between two wire protocol messages
       # by comparing class and field values.
@@ -460,6 +515,16 @@ module Mongo
       def validating_keys?
         @options[:validating_keys] if @options
       end
+
+      def max_serialized_size(max_bson_size, bson_overhead)
+        if max_bson_size && bson_overhead
+          max_bson_size + bson_overhead
+        elsif max_bson_size
+          max_bson_size
+        else
+          nil
+        end
+      end
     end
   end
 end
@@ -40,6 +40,13 @@ module Mongo
       # @api private
       INTERNAL_KEYS = Set.new(%w($clusterTime $db lsid signature txnNumber)).freeze
 
+      # Commands to which maxTimeMS derived from the timeout_ms option is
+      # not added: for getMore, maxTimeMS is the time the server waits for
+      # new documents of tailable cursors.
+      #
+      # @api private
+      NO_MAX_TIME_MS_COMMANDS = Set.new(%w(getMore killCursors)).freeze
+
       # Creates a new OP_MSG protocol message
       #
       # @example Create a OP_MSG wire protocol message
@@ -75,7 +82,9 @@ module Mongo
         unless main_document.is_a?(Hash)
           raise ArgumentError, "Main document must be a Hash, given: #{main_document.class}"
         end
-        @main_document = main_document
+        # The serialized sections are cached, thus the document must not
+        # change. It is copied so that the caller's document is not frozen.
+        @main_document = main_document.frozen? ? main_document : main_document.dup.freeze
         sequences.each_with_index do |section, index|
           unless section.is_a?(Section1)
             raise ArgumentError, "All sequences must be Section1 instances, got: #{section} at index #{index}"
@@ -143,6 +152,13 @@ module Mongo
 
       # Serializes message into bytes that can be sent on the wire.
       #
+      # The sections of the message are serialized once and the resulting
+      # bytes are reused by subsequent calls to this method and to
+      # #serialize_segments, which only write a new header. The main
+      # document is frozen when the message is created so that it cannot be
+      # modified afterwards; the documents of payload type 1 sections must
+      # not be modified after the message is first serialized.
+      #
       # @param [ BSON::ByteBuffer ] buffer where the message should be inserted.
       # @param [ Integer ] max_bson_size The maximum bson object size.
       #
@@ -150,26 +166,90 @@ module Mongo
       #
       # @since 2.5.0
       def serialize(buffer = BSON::ByteBuffer.new, max_bson_size = nil, bson_overhead = nil)
-        validate_document_size!(max_bson_size)
-
-        super
+        sections = validated_sections(max_bson_size, bson_overhead)
+
+        start = buffer.length
+        serialize_header(buffer)
+        fields.each do |field|
+          if field[:type] == Sections
+            sections.each do |bytes, _|
+              buffer.put_bytes(bytes)
+            end
+          else
+            field[:type].serialize(buffer, instance_variable_get(field[:name]), validating_keys?)
+          end
+        end
+        buffer.replace_int32(start, buffer.length - start)
         add_check_sum(buffer)
         buffer
       end
 
+      # Serializes message into a list of byte strings: the first string
+      # contains the message header and the flag bits, followed by one
+      # string per section (the payload type 0 section and each payload
+      # type 1 document sequence). The section strings are the frozen bytes
+      # cached by the message, which are not copied.
+      #
+      # @param [ Integer ] max_bson_size The maximum bson object size.
+      # @param [ Integer ] bson_overhead The additional allowance for
+      #   command data.
+      #
+      # @return [ Array<String> ] The serialized segments.
+      #
+      # @api private
+      def serialize_segments(max_bson_size = nil, bson_overhead = nil)
+        if flags.include?(:checksum_present)
+          # The checksum covers the whole message.
+          return super
+        end
+
+        sections = validated_sections(max_bson_size, bson_overhead)
+
+        header = BSON::ByteBuffer.new
+        serialize_header(header)
+        segments = [ nil ]
+        fields.each do |field|
+          if field[:type] == Sections
+            sections.each do |bytes, _|
+              segments << bytes
+            end
+          else
+            field[:type].serialize(header, instance_variable_get(field[:name]), validating_keys?)
+          end
+        end
+        header.replace_int32(0, header.length + sections.sum { |bytes, _| bytes.bytesize })
+        segments[0] = header.to_s
+        segments
+      end
+
       # Compress the message, if the command being sent permits compression.
       # Otherwise returns self.
       #
       # @param [ String, Symbol ] compressor The compressor to use.
       # @param [ Integer ] zlib_compression_level The zlib compression level to use.
+      # @param [ Integer ] zstd_compression_level The zstd compression level to use.
       #
       # @return [ Message ] A Protocol::Compressed message or self,
       #  depending on whether this message can be compressed.
       #
       # @since 2.5.0
       # @api private
-      def maybe_compress(compressor, zlib_compression_level = nil)
-        compress_if_possible(command.keys.first, compressor, zlib_compression_level)
+      def maybe_compress(compressor, zlib_compression_level = nil, zstd_compression_level = nil)
+        compress_if_possible(command.keys.first, compressor, zlib_compression_level, zstd_compression_level)
+      end
+
+      # Get the name of the command the message sends, without building
+      # the monitoring payload.
+      #
+      # @return [ String ] The command name.
+      #
+      # @api private
+      def command_name
+        @command_name ||= if @main_document.empty?
+          ''
+        else
+          @main_document.each_key { |key| break key.to_s }
+        end
       end
 
       # Reverse-populates the instance variables after deserialization sets
@@ -278,6 +358,29 @@ module Mongo
         num_inserts > 1  || num_updates > 1 || num_deletes > 1
       end
 
+      # Adds maxTimeMS to the command, unless it has a smaller maxTimeMS or
+      # is a command for which maxTimeMS has another meaning.
+      #
+      # @param [ Integer ] max_time_ms The maxTimeMS value.
+      #
+      # @return [ Msg ] The message with maxTimeMS, or self.
+      #
+      # @api private
+      def maybe_add_max_time_ms(max_time_ms)
+        if NO_MAX_TIME_MS_COMMANDS.include?(command_name)
+          return self
+        end
+
+        existing = @main_document[:maxTimeMS] || @main_document['maxTimeMS']
+        if existing && existing <= max_time_ms
+          return self
+        end
+
+        main_document = @main_document.reject { |key, _| key.to_s == 'maxTimeMS' }
+        main_document[:maxTimeMS] = max_time_ms
+        Msg.new(@flags, @options, main_document, *@sequences)
+      end
+
       def maybe_add_server_api(server_api)
         conflicts = {}
         %i(apiVersion apiStrict apiDeprecationErrors).each do |key|
@@ -300,21 +403,64 @@ module Mongo
 
       private
 
-      # Validate that the documents in this message are all smaller than the
-      # maxBsonObjectSize. If not, raise an exception.
-      def validate_document_size!(max_bson_size)
-        max_bson_size ||= Mongo::Server::ConnectionBase::DEFAULT_MAX_BSON_OBJECT_SIZE
+      # Returns the serialized sections of the message, after validating
+      # that they do not exceed the size limits.
+      #
+      # The type 0 section, which contains the command, may be up to
+      # max_bson_size plus bson_overhead bytes; each document of a type 1
+      # section must be smaller than max_bson_size (or the default maximum
+      # bson object size, if max_bson_size is not given).
+      #
+      # @return [ Array<Array<String, Integer | nil>> ] The bytes of each
+      #   section, with the size of the largest document of type 1 sections.
+      def validated_sections(max_bson_size, bson_overhead)
+        max_size = max_serialized_size(max_bson_size, bson_overhead)
+        max_document_size = max_bson_size || Mongo::Server::ConnectionBase::DEFAULT_MAX_BSON_OBJECT_SIZE
 
-        contains_too_large_document = @sections.any? do |section|
-          section[:type] == 1 &&
-            section[:payload][:sequence].any? do |document|
-              document.to_bson.length > max_bson_size
+        sections = serialized_sections
+        if sections.any? { |_, largest| largest && largest > max_document_size }
+          raise Error::MaxBSONSize.new('The document exceeds maximum allowed BSON object size after serialization')
+        end
+
+        if max_size
+          sections.each do |bytes, largest|
+            # The section type byte is not part of the document.
+            if largest.nil? && (serialized_size = bytes.bytesize - 1) > max_size
+              raise Error::MaxBSONSize,
+                "The document exceeds maximum allowed BSON object size after serialization. Serialized size: #{serialized_size} bytes, maximum allowed size: #{max_size} bytes"
             end
+          end
         end
 
-        if contains_too_large_document
-          raise Error::MaxBSONSize.new('The document exceeds maximum allowed BSON object size after serialization')
+        sections
+      end
+
+      # Serializes each section without a size limit, once.
+      def serialized_sections
+        @serialized_sections ||= @sections.map do |section|
+          buffer = BSON::ByteBuffer.new
+          Sections.serialize(buffer, [section], nil, validating_keys?)
+          bytes = buffer.to_s.freeze
+          if section[:type] == Sections::PayloadOne::TYPE
+            [ bytes, largest_document_size(bytes, section[:payload][:identifier]) ]
+          else
+            [ bytes, nil ]
+          end
+        end
+      end
+
+      # Returns the size of the largest document in a serialized type 1
+      # section, by reading the length prefix of each document.
+      def largest_document_size(bytes, identifier)
+        # Type byte, section size and null-terminated identifier.
+        offset = 1 + 4 + identifier.to_s.bytesize + 1
+        largest = 0
+        while offset < bytes.bytesize
+          size = bytes.byteslice(offset, 4).unpack1('l<')
+          largest = size if size > largest
+          offset += size
         end
+        largest
       end
 
       def command
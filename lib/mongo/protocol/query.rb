@@ -116,14 +116,15 @@ module Mongo
       #
       # @param [ String, Symbol ] compressor The compressor to use.
       # @param [ Integer ] zlib_compression_level The zlib compression level to use.
+      # @param [ Integer ] zstd_compression_level The zstd compression level to use.
       #
       # @return [ Message ] A Protocol::Compressed message or self,
       #  depending on whether this message can be compressed.
       #
       # @since 2.5.0
       # @api private
-      def maybe_compress(compressor, zlib_compression_level = nil)
-        compress_if_possible(selector.keys.first, compressor, zlib_compression_level)
+      def maybe_compress(compressor, zlib_compression_level = nil, zstd_compression_level = nil)
+        compress_if_possible(selector.keys.first, compressor, zlib_compression_level, zstd_compression_level)
       end
 
       # Serializes message into bytes that can be sent on the wire.
@@ -47,6 +47,9 @@ module Mongo
       # and the op code for the operation.
       module Header
 
+        # The size of a serialized message header in bytes.
+        SIZE = 16
+
         # Serializes the header value into the buffer
         #
         # @param buffer [ String ] Buffer to receive the serialized value.
@@ -65,7 +68,7 @@ module Mongo
         # @return [ Array<Fixnum> ] Array consisting of the deserialized
         #   length, request id, response id, and op code.
         def self.deserialize(buffer, options = {})
-          buffer.get_bytes(16).unpack(HEADER_PACK)
+          buffer.get_bytes(SIZE).unpack(HEADER_PACK)
         end
       end
 
@@ -276,13 +279,20 @@ module Mongo
           # @option options [ Boolean ] :deserialize_as_bson Whether to perform
           #   section deserialization using BSON types instead of native Ruby types
           #   wherever possible.
+          # @option options [ Boolean ] :raw_batches Whether to keep the
+          #   documents in cursor batches of the section as RawDocument
+          #   instances rather than deserializing them.
           #
           # @return [ Array<BSON::Document> ] Deserialized section.
           #
           # @since 2.5.0
           def self.deserialize(buffer, options = {})
             mode = options[:deserialize_as_bson] ? :bson : nil
-            BSON::Document.from_bson(buffer, **{ mode: mode })
+            if options[:raw_batches]
+              RawDocument.deserialize_reply(buffer, mode: mode)
+            else
+              BSON::Document.from_bson(buffer, **{ mode: mode })
+            end
           end
         end
 
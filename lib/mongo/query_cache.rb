@@ -71,6 +71,75 @@ module Mongo
         end
       end
 
+      # @return [ Integer | nil ] The maximum number of cursors each query
+      #   cache stores, or nil if the number of cursors is not limited.
+      attr_reader :max_entries
+
+      # Set the maximum number of cursors stored in each query cache (that
+      # is, in the cache of each thread and in the shared cache). When a
+      # cursor is stored in a cache which is full, the least recently used
+      # cursor is evicted.
+      #
+      # @example Limit each query cache to 1000 cursors.
+      #   QueryCache.max_entries = 1000
+      #
+      # @param [ Integer | nil ] value The maximum number of cursors, or nil
+      #   to not limit the number of cursors.
+      def max_entries=(value)
+        if value && value <= 0
+          raise ArgumentError, "Max entries must be positive: #{value}"
+        end
+        @max_entries = value
+      end
+
+      # @return [ Array<String> ] The namespaces whose query results are
+      #   cached in the shared cache.
+      def shared_namespaces
+        @shared_namespaces.to_a
+      end
+
+      # Set the namespaces whose query results are cached in a cache shared
+      # by all threads, rather than in the cache of the current thread.
+      #
+      # This is meant for reference collections which are read often and
+      # rarely written to. Writes performed by the driver in any thread clear
+      # the affected namespace from the shared cache, but the shared cache is
+      # not cleared by QueryCache.clear (and thus by the middleware); use
+      # QueryCache.clear_shared to clear it.
+      #
+      # Only cursors that have been fully iterated are returned from the
+      # shared cache.
+      #
+      # @example Share the cache of the countries collection.
+      #   QueryCache.shared_namespaces = ['app.countries']
+      #
+      # @param [ Array<String> ] value The namespaces, in the format
+      #   "database.collection".
+      def shared_namespaces=(value)
+        @shared_namespaces = value && !value.empty? ? Set.new(value) : nil
+      end
+
+      # Get the statistics of the query cache of the current thread.
+      #
+      # @example Get the statistics.
+      #   QueryCache.stats
+      #   # => { hits: 10, misses: 2, evictions: 0, size: 2 }
+      #
+      # @return [ Hash ] The number of queries served from the cache (hits),
+      #   the number of cacheable queries which were not in the cache
+      #   (misses), the number of cursors evicted because the cache was full
+      #   (evictions) and the number of cursors currently cached (size).
+      def stats
+        store.stats
+      end
+
+      # Get the statistics of the shared query cache.
+      #
+      # @return [ Hash ] The statistics, in the same format as #stats.
+      def shared_stats
+        shared_store.stats
+      end
+
       # Get the cached queries.
       #
       # @example Get the cached queries from the current thread.
@@ -78,17 +147,28 @@ module Mongo
       #
       # @return [ Hash ] The hash of cached queries.
       private def cache_table
-        Thread.current["[mongo]:query_cache"] ||= {}
+        store.table
       end
 
-      # Clear the query cache.
+      # Clear the query cache of the current thread.
       #
       # @example Clear the cache.
       #   QueryCache.clear
       #
       # @return [ nil ] Always nil.
       def clear
-        Thread.current["[mongo]:query_cache"] = nil
+        if store = Thread.current["[mongo]:query_cache"]
+          store.clear
+        end
+        nil
+      end
+
+      # Clear the shared query cache.
+      #
+      # @return [ nil ] Always nil.
+      def clear_shared
+        shared_store.clear
+        nil
       end
 
       # Clear the section of the query cache storing cursors with results
@@ -101,11 +181,8 @@ module Mongo
       #
       # @api private
       def clear_namespace(namespace)
-        cache_table.delete(namespace)
-        # The nil key is where cursors are stored that could potentially read from
-        # multiple collections. This key should be cleared on every write operation
-        # to prevent returning stale data.
-        cache_table.delete(nil)
+        store.clear_namespace(namespace)
+        shared_store.clear_namespace(namespace) if @shared_namespaces
         nil
       end
 
@@ -135,6 +212,9 @@ module Mongo
       #   results could potentially come from multiple collections. When true,
       #   these results will be stored under the nil namespace key and cleared
       #   on every write command.
+      # @option opts [ Array<String> | nil ] namespaces The namespaces
+      #   the results of a multi collection query come from, if known. If
+      #   given, the results are only cleared by writes to these namespaces.
       #
       # @return [ true ] Always true.
       #
@@ -143,8 +223,8 @@ module Mongo
         _cache_key = cache_key(**opts)
         _namespace_key = namespace_key(**opts)
 
-        cache_table[_namespace_key] ||= {}
-        cache_table[_namespace_key][_cache_key] = cursor
+        store_for(_namespace_key).set(_namespace_key, _cache_key, cursor,
+          opts[:multi_collection] ? opts[:namespaces] : nil)
 
         true
       end
@@ -183,11 +263,30 @@ module Mongo
         _namespace_key = namespace_key(**opts)
         _cache_key = cache_key(**opts)
 
-        namespace_hash = cache_table[_namespace_key]
-        return nil unless namespace_hash
+        cache_store = store_for(_namespace_key)
+        caching_cursor = cache_store.get(_namespace_key, _cache_key)
+        unless caching_cursor && usable?(cache_store, caching_cursor, limit)
+          cache_store.record_miss
+          return nil
+        end
+
+        cache_store.record_hit
+        caching_cursor
+      end
+
+      private
 
-        caching_cursor = namespace_hash[_cache_key]
-        return nil unless caching_cursor
+      # Whether the cached cursor can be used to fulfill a query with the
+      # specified limit.
+      def usable?(cache_store, caching_cursor, limit)
+        # Cursors in the shared cache may be iterated by several threads
+        # at the same time, which is only safe once they no longer
+        # retrieve documents from the server.
+        if cache_store.equal?(shared_store)
+          unless caching_cursor.closed? && caching_cursor.cached_docs
+            return false
+          end
+        end
 
         caching_cursor_limit = caching_cursor.view.limit
 
@@ -200,15 +299,33 @@ module Mongo
         # Otherwise, return nil because the stored cursor will not satisfy
         # the query.
         if limit && (caching_cursor_limit.nil? || caching_cursor_limit >= limit)
-          caching_cursor
+          true
         elsif limit.nil? && caching_cursor_limit.nil?
-          caching_cursor
+          true
         else
-          nil
+          false
         end
       end
 
-      private
+      # @return [ Store ] The query cache of the current thread.
+      def store
+        Thread.current["[mongo]:query_cache"] ||= Store.new
+      end
+
+      # @return [ Store ] The query cache shared by all threads.
+      def shared_store
+        @shared_store
+      end
+
+      # Get the cache in which cursors stored under the specified namespace
+      # key are stored.
+      def store_for(namespace_key)
+        if @shared_namespaces && @shared_namespaces.include?(namespace_key)
+          shared_store
+        else
+          store
+        end
+      end
 
       def cache_key(**opts)
         unless opts[:namespace]
@@ -242,6 +359,144 @@ module Mongo
       end
     end
 
+    # A query cache: cached cursors by namespace and cache key, with least
+    # recently used eviction when QueryCache.max_entries is set.
+    #
+    # @api private
+    class Store
+
+      # Create the store.
+      #
+      # @param [ true | false ] shared Whether the store is used by multiple
+      #   threads, in which case access to it is synchronized.
+      def initialize(shared: false)
+        @lock = Mutex.new if shared
+        @hits = 0
+        @misses = 0
+        @evictions = 0
+        clear
+      end
+
+      # @return [ Hash ] The cached cursors, by namespace key and cache key.
+      attr_reader :table
+
+      # Get the cursor stored for the specified keys, marking it as
+      # recently used.
+      #
+      # @return [ CachingCursor | nil ] The cursor, if any.
+      def get(namespace_key, cache_key)
+        synchronize do
+          namespace_hash = @table[namespace_key]
+          cursor = namespace_hash && namespace_hash[cache_key]
+          touch(namespace_key, cache_key) if cursor
+          cursor
+        end
+      end
+
+      # Store the cursor for the specified keys, evicting the least recently
+      # used cursors if the store is full.
+      #
+      # @param [ Array<String> | nil ] namespaces The namespaces the results
+      #   of a multi collection query come from, if known.
+      def set(namespace_key, cache_key, cursor, namespaces = nil)
+        synchronize do
+          (@table[namespace_key] ||= {})[cache_key] = cursor
+          if namespace_key.nil? && namespaces
+            @namespaces[cache_key] = namespaces
+          else
+            @namespaces.delete(cache_key)
+          end
+          touch(namespace_key, cache_key)
+
+          if max_entries = QueryCache.max_entries
+            while @lru.length > max_entries
+              evicted_namespace_key, evicted_cache_key = @lru.first.first
+              delete(evicted_namespace_key, evicted_cache_key)
+              @evictions += 1
+            end
+          end
+        end
+      end
+
+      # Remove the cursors which may have results from the namespace.
+      def clear_namespace(namespace)
+        synchronize do
+          if namespace_hash = @table[namespace]
+            namespace_hash.keys.each do |cache_key|
+              delete(namespace, cache_key)
+            end
+          end
+
+          # The nil key is where cursors are stored that could potentially
+          # read from multiple collections. Unless the collections are
+          # known, these cursors are cleared on every write operation to
+          # prevent returning stale data.
+          if namespace_hash = @table[nil]
+            namespace_hash.keys.each do |cache_key|
+              namespaces = @namespaces[cache_key]
+              if namespaces.nil? || namespaces.include?(namespace)
+                delete(nil, cache_key)
+              end
+            end
+          end
+        end
+      end
+
+      # Remove all cursors from the store. Statistics are retained.
+      def clear
+        synchronize do
+          @table = {}
+          @lru = {}
+          @namespaces = {}
+        end
+      end
+
+      def record_hit
+        synchronize { @hits += 1 }
+      end
+
+      def record_miss
+        synchronize { @misses += 1 }
+      end
+
+      # @return [ Hash ] The statistics of the store.
+      def stats
+        synchronize do
+          { hits: @hits, misses: @misses, evictions: @evictions, size: @lru.length }
+        end
+      end
+
+      private
+
+      def synchronize
+        if @lock
+          @lock.synchronize { yield }
+        else
+          yield
+        end
+      end
+
+      # Move the entry to the most recently used position. Hashes maintain
+      # insertion order, thus the first entry of @lru is the least recently
+      # used one.
+      def touch(namespace_key, cache_key)
+        key = [namespace_key, cache_key]
+        @lru.delete(key)
+        @lru[key] = true
+      end
+
+      def delete(namespace_key, cache_key)
+        @lru.delete([namespace_key, cache_key])
+        @namespaces.delete(cache_key) if namespace_key.nil?
+        if namespace_hash = @table[namespace_key]
+          namespace_hash.delete(cache_key)
+          @table.delete(namespace_key) if namespace_hash.empty?
+        end
+      end
+    end
+
+    @shared_store = Store.new(shared: true)
+
     # Rack middleware that activates the query cache for each request.
     class Middleware
 
@@ -0,0 +1,406 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+
+  # A document backed by its serialized BSON bytes, whose fields are only
+  # deserialized when they are accessed.
+  #
+  # Raw documents are returned by queries performed with the :raw option.
+  # They are useful for applications that pass documents through without
+  # inspecting them, or inspect only a few fields of each document, since
+  # they avoid materializing every document as a BSON::Document.
+  #
+  # @example Iterate over raw documents.
+  #   collection.find({}, raw: true).each do |doc|
+  #     io.write(doc.bson_bytes)
+  #   end
+  #
+  # @note A raw document references the bytes of the server reply which
+  #   contained it. Retaining any document of a batch retains the entire
+  #   reply in memory; call #to_h to obtain a standalone document.
+  class RawDocument
+    include Enumerable
+
+    # Fields of the cursor subdocument of a command reply whose elements
+    # are kept as raw documents.
+    #
+    # @api private
+    BATCH_KEYS = %w(firstBatch nextBatch).freeze
+
+    # Creates a raw document.
+    #
+    # @example Create a raw document from serialized BSON.
+    #   RawDocument.new({ a: 1 }.to_bson.to_s)
+    #
+    # @param [ String ] bytes The string containing the serialized document.
+    # @param [ Integer ] offset The position of the document in the string.
+    # @param [ Hash ] options The options.
+    #
+    # @option options [ nil | :bson ] :mode Decoding mode to use when
+    #   deserializing fields.
+    def initialize(bytes, offset = 0, options = {})
+      @bytes = bytes.encoding == BSON::BINARY ? bytes : bytes.b
+      @offset = offset
+      @length = @bytes.byteslice(offset, 4).unpack1(INT32_PACK)
+      @options = options
+    end
+
+    # @return [ Integer ] The size of the serialized document in bytes.
+    attr_reader :length
+
+    # Returns the serialized document.
+    #
+    # @return [ String ] The BSON bytes of this document.
+    def bson_bytes
+      @bytes.byteslice(@offset, @length)
+    end
+
+    # Returns the value of the specified field, deserializing only that
+    # field.
+    #
+    # @param [ String | Symbol ] key The field name.
+    #
+    # @return [ Object | nil ] The value of the field, or nil if the document
+    #   does not have the field.
+    def [](key)
+      return @document[key] if @document
+
+      key = key.to_s
+      self.class.each_element(@bytes, @offset) do |_, name, element_start, _, value_end|
+        if name == key
+          return self.class.decode_element(@bytes, element_start, value_end, @options)
+        end
+      end
+      nil
+    end
+
+    # Returns the value of the specified field.
+    #
+    # @param [ String | Symbol ] key The field name.
+    # @param [ Object ] default The value to return if the field is missing.
+    #
+    # @return [ Object ] The value of the field.
+    #
+    # @raise [ KeyError ] If the field is missing and no default is given.
+    def fetch(key, *default)
+      if key?(key)
+        self[key]
+      elsif block_given?
+        yield key
+      elsif !default.empty?
+        default.first
+      else
+        raise KeyError, "key not found: #{key.inspect}"
+      end
+    end
+
+    # Whether the document has the specified field. Does not deserialize
+    # any values.
+    #
+    # @param [ String | Symbol ] key The field name.
+    #
+    # @return [ true | false ] Whether the field is present.
+    def key?(key)
+      key = key.to_s
+      self.class.each_element(@bytes, @offset) do |_, name, _, _, _|
+        return true if name == key
+      end
+      false
+    end
+    alias :has_key? :key?
+    alias :include? :key?
+
+    # Returns the field names of the document. Does not deserialize any
+    # values.
+    #
+    # @return [ Array<String> ] The field names.
+    def keys
+      [].tap do |keys|
+        self.class.each_element(@bytes, @offset) do |_, name, _, _, _|
+          keys << name
+        end
+      end
+    end
+
+    # Iterates over the fields of the document, deserializing the entire
+    # document.
+    #
+    # @yieldparam [ String ] key The field name.
+    # @yieldparam [ Object ] value The field value.
+    def each(&block)
+      to_h.each(&block)
+    end
+
+    # Deserializes the entire document.
+    #
+    # @return [ BSON::Document ] The deserialized document.
+    def to_h
+      @document ||= BSON::Document.from_bson(BSON::ByteBuffer.new(bson_bytes), **{ mode: @options[:mode] })
+    end
+    alias :to_document :to_h
+
+    # Serializes the document by copying its bytes into the buffer, which
+    # permits raw documents to be embedded in or sent as other documents.
+    #
+    # @param [ BSON::ByteBuffer ] buffer The buffer to write into.
+    #
+    # @return [ BSON::ByteBuffer ] The buffer.
+    def to_bson(buffer = BSON::ByteBuffer.new, validating_keys = nil)
+      buffer.put_bytes(bson_bytes)
+    end
+
+    # @return [ String ] The BSON type of the document.
+    def bson_type
+      BSON::Hash::BSON_TYPE
+    end
+
+    # Compares this document to another document.
+    #
+    # @param [ Object ] other The other object.
+    #
+    # @return [ true | false ] Whether the documents are equal.
+    def ==(other)
+      case other
+      when RawDocument
+        bson_bytes == other.bson_bytes
+      when ::Hash
+        to_h == other
+      else
+        false
+      end
+    end
+
+    # Returns the document in relaxed extended JSON.
+    #
+    # The serialized document is transcoded directly. Only values of types
+    # other than documents, arrays, strings, numbers, booleans, nulls and
+    # object ids are deserialized, one at a time, to be converted.
+    #
+    # @example Convert the document to extended JSON.
+    #   doc.to_extended_json
+    #   # => '{"_id":{"$oid":"5f9a..."},"name":"Alice"}'
+    #
+    # @return [ String ] The extended JSON representation of the document.
+    #
+    # @raise [ Error::UnmetDependency ] If the document contains a value of
+    #   another type and the bson gem is older than 4.11, which added
+    #   extended JSON conversion.
+    def to_extended_json
+      String.new(encoding: BSON::UTF8).tap do |json|
+        self.class.write_extended_json(json, @bytes, @offset, false)
+      end
+    end
+
+    # @return [ String ] Human-readable representation of the document.
+    def inspect
+      "#<Mongo::RawDocument length=#{length} keys=#{keys.inspect}>"
+    end
+
+    # Deserializes a command reply document, keeping the documents in
+    # cursor batches (cursor.firstBatch and cursor.nextBatch) as raw
+    # documents referencing the reply bytes.
+    #
+    # @param [ BSON::ByteBuffer ] buffer The buffer positioned at the
+    #   start of the reply document.
+    # @param [ Hash ] options The options.
+    #
+    # @option options [ nil | :bson ] :mode Decoding mode.
+    #
+    # @return [ BSON::Document ] The deserialized reply.
+    #
+    # @api private
+    def self.deserialize_reply(buffer, options = {})
+      length = buffer.get_int32
+      bytes = String.new([length].pack(INT32_PACK), encoding: BSON::BINARY)
+      bytes << buffer.get_bytes(length - 4)
+
+      BSON::Document.new.tap do |reply|
+        each_element(bytes, 0) do |type, name, element_start, value_start, value_end|
+          reply[name] = if name == 'cursor' && type == EMBEDDED_DOCUMENT
+            decode_cursor(bytes, value_start, options)
+          else
+            decode_element(bytes, element_start, value_end, options)
+          end
+        end
+      end
+    end
+
+    # @api private
+    def self.decode_cursor(bytes, offset, options)
+      BSON::Document.new.tap do |cursor|
+        each_element(bytes, offset) do |type, name, element_start, value_start, value_end|
+          cursor[name] = if BATCH_KEYS.include?(name) && type == ARRAY
+            [].tap do |batch|
+              each_element(bytes, value_start) do |_, _, _, doc_start, _|
+                batch << new(bytes, doc_start, options)
+              end
+            end
+          else
+            decode_element(bytes, element_start, value_end, options)
+          end
+        end
+      end
+    end
+
+    # Deserializes a single element by wrapping it into a document of its
+    # own.
+    #
+    # @api private
+    def self.decode_element(bytes, element_start, value_end, options)
+      element_length = value_end - element_start
+      doc = String.new([element_length + 5].pack(INT32_PACK), encoding: BSON::BINARY)
+      doc << bytes.byteslice(element_start, element_length)
+      doc << BSON::NULL_BYTE
+      BSON::Document.from_bson(BSON::ByteBuffer.new(doc), **{ mode: options[:mode] }).values.first
+    end
+
+    # Appends the relaxed extended JSON representation of the document or
+    # array starting at offset to the string.
+    #
+    # @api private
+    def self.write_extended_json(json, bytes, offset, array)
+      json << (array ? '[' : '{')
+      first = true
+      each_element(bytes, offset) do |type, name, element_start, value_start, value_end|
+        json << ',' unless first
+        first = false
+        json << name.to_json << ':' unless array
+
+        case type
+        when DOUBLE
+          value = bytes.byteslice(value_start, 8).unpack1(DOUBLE_PACK)
+          if value.finite?
+            json << value.to_s
+          else
+            write_extended_json_value(json, bytes, element_start, value_end)
+          end
+        when STRING
+          json << bytes.byteslice(value_start + 4, int32_at(bytes, value_start) - 1).
+            force_encoding(BSON::UTF8).to_json
+        when EMBEDDED_DOCUMENT
+          write_extended_json(json, bytes, value_start, false)
+        when ARRAY
+          write_extended_json(json, bytes, value_start, true)
+        when OBJECT_ID
+          json << '{"$oid":"' << bytes.byteslice(value_start, 12).unpack1('H*') << '"}'
+        when BOOLEAN
+          json << (bytes.getbyte(value_start) == 1 ? 'true' : 'false')
+        when NULL
+          json << 'null'
+        when INT32
+          json << int32_at(bytes, value_start).to_s
+        when INT64
+          json << bytes.byteslice(value_start, 8).unpack1(INT64_PACK).to_s
+        else
+          write_extended_json_value(json, bytes, element_start, value_end)
+        end
+      end
+      json << (array ? ']' : '}')
+    end
+
+    # @api private
+    def self.write_extended_json_value(json, bytes, element_start, value_end)
+      value = decode_element(bytes, element_start, value_end, {})
+      unless value.respond_to?(:as_extended_json)
+        raise Error::UnmetDependency, "Cannot convert a #{value.class} value to extended JSON " \
+          "because the bson gem is older than 4.11 (installed version: #{BSON::VERSION})"
+      end
+      json << value.as_extended_json(mode: :relaxed).to_json
+    end
+
+    # Iterates over the elements of the document starting at offset,
+    # without deserializing any values.
+    #
+    # @yieldparam [ Integer ] type The BSON type byte of the element.
+    # @yieldparam [ String ] name The field name.
+    # @yieldparam [ Integer ] element_start The position of the type byte.
+    # @yieldparam [ Integer ] value_start The position of the value.
+    # @yieldparam [ Integer ] value_end The position after the value.
+    #
+    # @api private
+    def self.each_element(bytes, offset)
+      doc_end = offset + int32_at(bytes, offset) - 1
+      pos = offset + 4
+      while pos < doc_end
+        type = bytes.getbyte(pos)
+        name_end = bytes.index(BSON::NULL_BYTE, pos + 1)
+        unless name_end
+          raise Error::InvalidDocument
+        end
+        name = bytes.byteslice(pos + 1, name_end - pos - 1).force_encoding(BSON::UTF8)
+        value_start = name_end + 1
+        value_end = value_start + value_size(bytes, type, value_start)
+        yield type, name, pos, value_start, value_end
+        pos = value_end
+      end
+    end
+
+    # @api private
+    def self.value_size(bytes, type, pos)
+      case type
+      when 0x01, 0x09, 0x11, 0x12 then 8
+      when 0x02, 0x0D, 0x0E then 4 + int32_at(bytes, pos)
+      when EMBEDDED_DOCUMENT, ARRAY, 0x0F then int32_at(bytes, pos)
+      when 0x05 then 5 + int32_at(bytes, pos)
+      when 0x06, 0x0A, 0x7F, 0xFF then 0
+      when 0x07 then 12
+      when 0x08 then 1
+      when 0x0B
+        pattern_end = bytes.index(BSON::NULL_BYTE, pos)
+        bytes.index(BSON::NULL_BYTE, pattern_end + 1) + 1 - pos
+      when 0x0C then 4 + int32_at(bytes, pos) + 12
+      when 0x10 then 4
+      when 0x13 then 16
+      else
+        raise Error::InvalidDocument
+      end
+    end
+
+    # @api private
+    def self.int32_at(bytes, pos)
+      bytes.byteslice(pos, 4).unpack1(INT32_PACK)
+    end
+
+    INT32_PACK = 'l<'
+
+    INT64_PACK = 'q<'
+
+    DOUBLE_PACK = 'E'
+
+    DOUBLE = 0x01
+
+    STRING = 0x02
+
+    EMBEDDED_DOCUMENT = 0x03
+
+    ARRAY = 0x04
+
+    OBJECT_ID = 0x07
+
+    BOOLEAN = 0x08
+
+    NULL = 0x0A
+
+    INT32 = 0x10
+
+    INT64 = 0x12
+
+    private_constant :INT32_PACK, :INT64_PACK, :DOUBLE_PACK, :DOUBLE, :STRING,
+      :EMBEDDED_DOCUMENT, :ARRAY, :OBJECT_ID, :BOOLEAN, :NULL, :INT32, :INT64
+  end
+end
@@ -22,6 +22,13 @@ module Mongo
   # @since 2.1.0
   module Retryable
 
+    # The minimum time, in seconds, to wait for the reply of the server
+    # a hedged read is first sent to, when the delay is derived from the
+    # round trip times to the server.
+    #
+    # @api private
+    HEDGED_READ_MIN_DELAY = 0.01
+
     # Execute a read operation returning a cursor with retrying.
     #
     # This method performs server selection for the specified server selector
@@ -56,19 +63,33 @@ module Mongo
     # @param [ Mongo::ServerSelector::Selectable ] server_selector Server
     #   selector for the operation.
     # @param [ CollectionView ] view The +CollectionView+ defining the query.
+    # @param [ true | false ] hedge Whether the initial query may be hedged,
+    #   if hedged reads are enabled for the client and a context is given.
+    #   The block must then be safe to call concurrently for two servers,
+    #   and must send the query with the session of the context it is
+    #   passed as its second argument.
+    # @param [ Operation::Context | nil ] context The context of the
+    #   operation, whose deadline limits server selection and retries.
     # @param [ Proc ] block The block to execute.
     #
     # @return [ Cursor ] The cursor for the result set.
-    def read_with_retry_cursor(session, server_selector, view, &block)
-      read_with_retry(session, server_selector) do |server|
-        result = yield server
+    def read_with_retry_cursor(session, server_selector, view, hedge: false, context: nil, &block)
+      read_with_retry(session, server_selector, context: context) do |server, retrying|
+        cursor_session = session
+        result, server = if hedge && context && !retrying && hedge_read?(session, server_selector)
+          hedged_read(server, server_selector, context, view, &block).tap do |*, attempt_context|
+            cursor_session = attempt_context.session
+          end
+        else
+          [ yield(server, context), server ]
+        end
 
         # RUBY-2367: This will be updated to allow the query cache to
         # cache cursors with multi-batch results.
         if QueryCache.enabled? && !view.collection.system_collection?
-          CachingCursor.new(view, result, server, session: session)
+          CachingCursor.new(view, result, server, session: cursor_session)
         else
-          Cursor.new(view, result, server, session: session)
+          Cursor.new(view, result, server, session: cursor_session)
         end
       end
     end
@@ -103,10 +124,12 @@ module Mongo
     #   run on.
     # @param [ Mongo::ServerSelector::Selectable ] server_selector Server
     #   selector for the operation.
+    # @param [ Operation::Context | nil ] context The context of the
+    #   operation, whose deadline limits server selection and retries.
     # @param [ Proc ] block The block to execute.
     #
     # @return [ Result ] The result of the operation.
-    def read_with_retry(session = nil, server_selector = nil, &block)
+    def read_with_retry(session = nil, server_selector = nil, context: nil, &block)
       if session.nil? && server_selector.nil?
         # Older versions of Mongoid call read_with_retry without arguments.
         # This is already not correct in a MongoDB 3.6+ environment with
@@ -122,13 +145,13 @@ module Mongo
         # bearing node in the cluster; the block may select a different server
         # which is fine.
         server_selector = ServerSelector.get(mode: :primary_preferred)
-        legacy_read_with_retry(nil, server_selector, &block)
+        legacy_read_with_retry(nil, server_selector, context, &block)
       elsif session && session.retry_reads?
-        modern_read_with_retry(session, server_selector, &block)
+        modern_read_with_retry(session, server_selector, context, &block)
       elsif client.max_read_retries > 0
-        legacy_read_with_retry(session, server_selector, &block)
+        legacy_read_with_retry(session, server_selector, context, &block)
       else
-        server = select_server(cluster, server_selector, session)
+        server = select_server(cluster, server_selector, session, context)
         begin
           yield server
         rescue Error::SocketError, Error::SocketTimeoutError, Error::OperationFailure => e
@@ -195,6 +218,8 @@ module Mongo
     # @param [ nil | Hash | WriteConcern::Base ] write_concern The write concern.
     # @param [ true | false ] ending_transaction True if the write operation is abortTransaction or
     #   commitTransaction, false otherwise.
+    # @param [ Operation::Context | nil ] context The context of the
+    #   operation, whose deadline limits server selection and retries.
     # @param [ Proc ] block The block to execute.
     #
     # @yieldparam [ Server ] server The server to which the write should be sent.
@@ -203,22 +228,22 @@ module Mongo
     # @return [ Result ] The result of the operation.
     #
     # @since 2.1.0
-    def write_with_retry(session, write_concern, ending_transaction = false, &block)
+    def write_with_retry(session, write_concern, ending_transaction = false, context: nil, &block)
       if ending_transaction && !session
         raise ArgumentError, 'Cannot end a transaction without a session'
       end
 
       unless ending_transaction || retry_write_allowed?(session, write_concern)
-        return legacy_write_with_retry(nil, session, &block)
+        return legacy_write_with_retry(nil, session, context: context, &block)
       end
 
       # If we are here, session is not nil. A session being nil would have
       # failed retry_write_allowed? check.
 
-      server = select_server(cluster, ServerSelector.primary, session)
+      server = select_server(cluster, ServerSelector.primary, session, context)
 
       unless ending_transaction || server.retry_writes?
-        return legacy_write_with_retry(server, session, &block)
+        return legacy_write_with_retry(server, session, context: context, &block)
       end
 
       txn_num = if session.in_transaction?
@@ -234,7 +259,7 @@ module Mongo
         if !e.label?('RetryableWriteError')
           raise e
         end
-        retry_write(e, session, txn_num, &block)
+        retry_write(e, session, txn_num, context, &block)
       rescue Error::OperationFailure => e
         e.add_note('modern retry')
         e.add_note("attempt 1")
@@ -244,7 +269,7 @@ module Mongo
           raise e
         end
 
-        retry_write(e, session, txn_num, &block)
+        retry_write(e, session, txn_num, context, &block)
       end
     end
 
@@ -260,13 +285,15 @@ module Mongo
     #
     # @param [ nil | Session ] session Optional session to use with the operation.
     # @param [ nil | Hash | WriteConcern::Base ] write_concern The write concern.
+    # @param [ Operation::Context | nil ] context The context of the
+    #   operation, whose deadline limits server selection and retries.
     #
     # @yieldparam [ Server ] server The server to which the write should be sent.
     #
     # @api private
-    def nro_write_with_retry(session, write_concern, &block)
+    def nro_write_with_retry(session, write_concern, context: nil, &block)
       if session && session.client.options[:retry_writes]
-        server = select_server(cluster, ServerSelector.primary, session)
+        server = select_server(cluster, ServerSelector.primary, session, context)
         begin
           yield server
         rescue Error::SocketError, Error::SocketTimeoutError, Error::OperationFailure => e
@@ -274,7 +301,7 @@ module Mongo
           raise e
         end
       else
-        legacy_write_with_retry(nil, session, &block)
+        legacy_write_with_retry(nil, session, context: context, &block)
       end
     end
 
@@ -288,24 +315,26 @@ module Mongo
     #   operation. If not provided, the current primary will be retrieved from
     #   the cluster.
     # @param [ nil | Session ] session Optional session to use with the operation.
+    # @param [ Operation::Context | nil ] context The context of the
+    #   operation, whose deadline limits server selection and retries.
     #
     # @yieldparam [ Server ] server The server to which the write should be sent.
     #
     # @api private
-    def legacy_write_with_retry(server = nil, session = nil)
+    def legacy_write_with_retry(server = nil, session = nil, context: nil)
       # This is the pre-session retry logic, and is not subject to
       # current retryable write specifications.
       # In particular it does not retry on SocketError and SocketTimeoutError.
       attempt = 0
       begin
         attempt += 1
-        server ||= select_server(cluster, ServerSelector.primary, session)
+        server ||= select_server(cluster, ServerSelector.primary, session, context)
         yield server
       rescue Error::OperationFailure => e
         e.add_note('legacy retry')
         e.add_note("attempt #{attempt}")
         server = nil
-        if attempt > client.max_write_retries
+        if attempt > client.max_write_retries || timeout_expired?(e, context)
           raise e
         end
         if e.label?('RetryableWriteError')
@@ -320,52 +349,52 @@ module Mongo
 
     private
 
-    def modern_read_with_retry(session, server_selector, &block)
-      server = select_server(cluster, server_selector, session)
+    def modern_read_with_retry(session, server_selector, context, &block)
+      server = select_server(cluster, server_selector, session, context)
       begin
         yield server
       rescue Error::SocketError, Error::SocketTimeoutError => e
         e.add_note('modern retry')
         e.add_note("attempt 1")
-        if session.in_transaction?
+        if session.in_transaction? || timeout_expired?(e, context)
           raise e
         end
-        retry_read(e, server_selector, session, &block)
+        retry_read(e, server_selector, session, context, &block)
       rescue Error::OperationFailure => e
         e.add_note('modern retry')
         e.add_note("attempt 1")
-        if session.in_transaction? || !e.write_retryable?
+        if session.in_transaction? || !e.write_retryable? || timeout_expired?(e, context)
           raise e
         end
-        retry_read(e, server_selector, session, &block)
+        retry_read(e, server_selector, session, context, &block)
       end
     end
 
-    def legacy_read_with_retry(session, server_selector)
+    def legacy_read_with_retry(session, server_selector, context)
       attempt = 0
-      server = select_server(cluster, server_selector, session)
+      server = select_server(cluster, server_selector, session, context)
       begin
         attempt += 1
         yield server
       rescue Error::SocketError, Error::SocketTimeoutError => e
         e.add_note('legacy retry')
         e.add_note("attempt #{attempt}")
-        if attempt > client.max_read_retries || (session && session.in_transaction?)
+        if attempt > client.max_read_retries || (session && session.in_transaction?) || timeout_expired?(e, context)
           raise e
         end
         log_retry(e, message: 'Legacy read retry')
-        server = select_server(cluster, server_selector, session)
+        server = select_server(cluster, server_selector, session, context)
         retry
       rescue Error::OperationFailure => e
         e.add_note('legacy retry')
         e.add_note("attempt #{attempt}")
         if e.retryable? && !(session && session.in_transaction?)
-          if attempt > client.max_read_retries
+          if attempt > client.max_read_retries || timeout_expired?(e, context)
             raise e
           end
           log_retry(e, message: 'Legacy read retry')
           sleep(client.read_retry_interval)
-          server = select_server(cluster, server_selector, session)
+          server = select_server(cluster, server_selector, session, context)
           retry
         else
           raise e
@@ -373,6 +402,135 @@ module Mongo
       end
     end
 
+    # Whether a read with the server selector may be hedged.
+    #
+    # Only nearest and secondary preferred reads, which do not require a
+    # particular server, are hedged, and only in replica sets; mongos hedges
+    # reads itself when requested with the hedge read preference option.
+    # Reads using explicit sessions are not hedged, since the hedged query
+    # is sent with a different session.
+    def hedge_read?(session, server_selector)
+      client.options[:hedged_reads] &&
+        session && session.implicit? && !session.in_transaction? &&
+        cluster.replica_set? &&
+        (server_selector.is_a?(ServerSelector::Nearest) ||
+          server_selector.is_a?(ServerSelector::SecondaryPreferred))
+    end
+
+    # Sends the initial query of a cursor to the server and, if the server
+    # has not replied when the hedged read delay elapses, also to another
+    # suitable server. The first successful reply is used; the cursors
+    # which the other query opens are killed.
+    #
+    # Sessions are not thread-safe, so the query sent to the other server
+    # uses its own implicit session. The session of the query whose reply
+    # is not used is ended once its cursor is killed.
+    #
+    # If both queries fail, the error of the query sent to the original
+    # server is raised, so that it is retried as usual.
+    #
+    # @param [ Operation::Context ] context The context of the operation,
+    #   whose session must be implicit.
+    #
+    # @return [ Array<Operation::Result, Server, Operation::Context> ] The
+    #   result of the successful query, the server it was sent to and the
+    #   context, holding the session, it was sent with.
+    def hedged_read(server, server_selector, context, view, &block)
+      lock = Mutex.new
+      condition = ConditionVariable.new
+      outcomes = []
+      winner = nil
+
+      attempt = lambda do |target, attempt_context|
+        Thread.new do
+          outcome = begin
+            [ target, attempt_context, block.call(target, attempt_context), nil ]
+          rescue => e
+            [ target, attempt_context, nil, e ]
+          end
+          lose = lock.synchronize do
+            outcomes << outcome
+            condition.broadcast
+            !winner.nil?
+          end
+          # The winner was already chosen, clean up after this query.
+          discard_hedged_read(outcome, view) if lose
+        end
+      end
+
+      attempt.call(server, context)
+      deadline = Utils.monotonic_time + hedged_read_delay(server)
+      lock.synchronize do
+        while outcomes.empty? && (remaining = deadline - Utils.monotonic_time) > 0
+          condition.wait(lock, remaining)
+        end
+      end
+
+      attempts = 1
+      if outcomes.empty? && other = hedged_read_server(server_selector, server)
+        attempt.call(other, context.with_session(client.get_session(implicit: true)))
+        attempts += 1
+      end
+
+      losers = nil
+      lock.synchronize do
+        until (winner = outcomes.detect { |*, error| error.nil? }) || outcomes.length == attempts
+          condition.wait(lock)
+        end
+        # If there is no winner, all queries have completed.
+        losers = outcomes - [ winner ] if winner
+      end
+
+      unless winner
+        outcomes.each do |_, attempt_context, *|
+          # The original session is used to retry the read.
+          attempt_context.session&.end_session unless attempt_context.equal?(context)
+        end
+        raise outcomes.detect { |target, *| target == server }.last
+      end
+
+      unless losers.empty?
+        Thread.new do
+          losers.each { |outcome| discard_hedged_read(outcome, view) }
+        end
+      end
+
+      target, attempt_context, result, _ = winner
+      [ result, target, attempt_context ]
+    end
+
+    def hedged_read_delay(server)
+      client.options[:hedged_read_delay] ||
+        [ server.p90_round_trip_time || 0, HEDGED_READ_MIN_DELAY ].max
+    end
+
+    def hedged_read_server(server_selector, server)
+      server_selector.suitable_servers(cluster).detect do |candidate|
+        candidate != server
+      end
+    end
+
+    # Kills the cursor opened by a hedged query whose result is not used,
+    # with the session the query was sent with, and then ends that session.
+    def discard_hedged_read(outcome, view)
+      target, context, result, error = outcome
+      unless error || result.cursor_id == 0
+        spec = {
+          coll_name: view.collection.name,
+          db_name: view.database.name,
+          cursor_ids: [ result.cursor_id ],
+        }
+        begin
+          Operation::KillCursors.new(spec).execute(target,
+            context: Operation::Context.new(client: client, session: context.session))
+        rescue Error, Error::AuthError => e
+          Logger.logger.warn("Failed to kill the cursor of a hedged read: #{e.class}: #{e}")
+        end
+      end
+    ensure
+      context.session&.end_session
+    end
+
     def retry_write_allowed?(session, write_concern)
       unless session && session.retry_writes?
         return false
@@ -388,9 +546,9 @@ module Mongo
       end
     end
 
-    def retry_read(original_error, server_selector, session, &block)
+    def retry_read(original_error, server_selector, session, context, &block)
       begin
-        server = select_server(cluster, server_selector, session)
+        server = select_server(cluster, server_selector, session, context)
       rescue Error, Error::AuthError => e
         original_error.add_note("later retry failed: #{e.class}: #{e}")
 
@@ -423,13 +581,16 @@ module Mongo
       raise original_error
     end
 
-    def retry_write(original_error, session, txn_num, &block)
+    def retry_write(original_error, session, txn_num, context, &block)
       # We do not request a scan of the cluster here, because error handling
       # for the error which triggered the retry should have updated the
       # server description and/or topology as necessary (specifically,
       # a socket error or a not master error should have marked the respective
       # server unknown). Here we just need to wait for server selection.
-      server = select_server(cluster, ServerSelector.primary, session)
+      if timeout_expired?(original_error, context)
+        raise Error::RaiseOriginalError
+      end
+      server = select_server(cluster, ServerSelector.primary, session, context)
       unless server.retry_writes?
         # Do not need to add "modern retry" here, it should already be on
         # the first exception.
@@ -469,8 +630,23 @@ module Mongo
 
     # This is a separate method to make it possible for the test suite to
     # assert that server selection is performed during retry attempts.
-    def select_server(cluster, server_selector, session)
-      server_selector.select_server(cluster, nil, session)
+    def select_server(cluster, server_selector, session, context = nil)
+      if timeout = context&.remaining_timeout_sec
+        server_selector.select_server(cluster, nil, session, timeout: timeout)
+      else
+        server_selector.select_server(cluster, nil, session)
+      end
+    end
+
+    # Whether the deadline of the operation has passed, in which case the
+    # operation is not retried.
+    def timeout_expired?(error, context)
+      if context&.deadline_expired?
+        error.add_note('timeout_ms expired')
+        true
+      else
+        false
+      end
     end
 
     # Log a warning so that any application slow down is immediately obvious.
@@ -76,12 +76,16 @@ module Mongo
       @last_scan = nil
       @last_scan_monotime = nil
       unless options[:monitoring_io] == false
-        @monitor = Monitor.new(self, event_listeners, monitoring,
-          options.merge(
-            app_metadata: cluster.monitor_app_metadata,
-            push_monitor_app_metadata: cluster.push_monitor_app_metadata,
-            heartbeat_interval: cluster.heartbeat_interval,
-        ))
+        monitor_options = options.merge(
+          app_metadata: cluster.monitor_app_metadata,
+          push_monitor_app_metadata: cluster.push_monitor_app_metadata,
+          heartbeat_interval: cluster.heartbeat_interval,
+        )
+        @monitor = if options[:shared_monitoring] && !options[:load_balancer]
+          SharedMonitor::Subscription.new(self, monitor_options)
+        else
+          Monitor.new(self, event_listeners, monitoring, monitor_options)
+        end
         unless _monitor == false
           start_monitoring
         end
@@ -96,8 +100,10 @@ module Mongo
     # @return [ Cluster ] cluster The server cluster.
     attr_reader :cluster
 
-    # @return [ nil | Monitor ] monitor The server monitor. nil if the servenr
-    #   was created with monitoring_io: false option.
+    # @return [ nil | Monitor | SharedMonitor::Subscription ] monitor The
+    #   server monitor, or the subscription to the shared monitor of the
+    #   server if the server was created with the :shared_monitoring option.
+    #   nil if the servenr was created with monitoring_io: false option.
     attr_reader :monitor
 
     # @return [ Hash ] The options hash.
@@ -176,6 +182,8 @@ module Mongo
                    :max_message_size,
                    :tags,
                    :average_round_trip_time,
+                   :min_round_trip_time,
+                   :p90_round_trip_time,
                    :mongos?,
                    :other?,
                    :primary?,
@@ -205,7 +213,13 @@ module Mongo
     #   of this server by its monitor, if one is running.
     #
     # @api private
-    attr_reader :scan_semaphore
+    def scan_semaphore
+      if monitor.is_a?(SharedMonitor::Subscription)
+        monitor.scan_semaphore || @scan_semaphore
+      else
+        @scan_semaphore
+      end
+    end
 
     # @return [ RoundTripTimeAverager ] Round trip time averager object.
     # @api private
@@ -383,6 +397,20 @@ module Mongo
       end
     end
 
+    # Get the number of operations in progress on this server, as the
+    # number of connections checked out of its connection pool.
+    #
+    # @return [ Integer ] The number of operations in progress.
+    #
+    # @api private
+    def operation_count
+      if pool = @pool
+        pool.checked_out_count
+      else
+        0
+      end
+    end
+
     # Determine if the provided tags are a subset of the server's tags.
     #
     # @example Are the provided tags a subset of the server's tags.
@@ -422,11 +450,15 @@ module Mongo
     #     connection.dispatch([ command ])
     #   end
     #
+    # @param [ Float | nil ] timeout The time, in seconds, remaining until
+    #   the deadline of the operation, which limits the wait for a
+    #   connection.
+    #
     # @return [ Object ] The result of the block execution.
     #
     # @since 2.3.0
-    def with_connection(service_id: nil, &block)
-      pool.with_connection(service_id: service_id, &block)
+    def with_connection(service_id: nil, timeout: nil, &block)
+      pool.with_connection(service_id: service_id, timeout: timeout, &block)
     end
 
     # Handle handshake failure.
@@ -607,5 +639,6 @@ require 'mongo/server/connection'
 require 'mongo/server/connection_pool'
 require 'mongo/server/description'
 require 'mongo/server/monitor'
+require 'mongo/server/shared_monitor'
 require 'mongo/server/round_trip_time_averager'
 require 'mongo/server/push_monitor'
@@ -165,20 +165,25 @@ module Mongo
         if Lint.enabled? && !@socket
           raise Error::LintError, "Trying to deliver a message over a disconnected connection (to #{address})"
         end
-        buffer = serialize(message, context)
+        buffers = serialize_segments(message, context)
+        options = with_deadline(options, context)
         ensure_connected do |socket|
           operation_id = Monitoring.next_operation_id
-          started_event = command_started(address, operation_id, message.payload,
-            socket_object_id: socket.object_id, connection_id: id,
-            connection_generation: generation,
-            server_connection_id: description.server_connection_id,
-            service_id: description.service_id,
-          )
+          # The event payload is only built when there are command
+          # subscribers to publish the events to.
+          if monitoring.subscribers?(Monitoring::COMMAND)
+            started_event = command_started(address, operation_id, message.payload,
+              socket_object_id: socket.object_id, connection_id: id,
+              connection_generation: generation,
+              server_connection_id: description.server_connection_id,
+              service_id: description.service_id,
+            )
+          end
           start = Utils.monotonic_time
           result = nil
           begin
             result = add_server_diagnostics do
-              socket.write(buffer.to_s)
+              socket.write(*buffers)
               if message.replyable?
                 Protocol::Message.deserialize(socket, max_message_size, message.request_id, options)
               else
@@ -187,19 +192,25 @@ module Mongo
             end
           rescue Exception => e
             total_duration = Utils.monotonic_time - start
-            command_failed(nil, address, operation_id, message.payload,
-              e.message, total_duration,
-              started_event: started_event,
-              service_id: description.service_id,
-            )
+            if started_event
+              command_failed(nil, address, operation_id, message.payload,
+                e.message, total_duration,
+                started_event: started_event,
+                service_id: description.service_id,
+              )
+            end
+            record_command_metrics(message, total_duration, false)
             raise
           else
             total_duration = Utils.monotonic_time - start
-            command_completed(result, address, operation_id, message.payload,
-              total_duration,
-              started_event: started_event,
-              service_id: description.service_id,
-            )
+            if started_event
+              command_completed(result, address, operation_id, message.payload,
+                total_duration,
+                started_event: started_event,
+                service_id: description.service_id,
+              )
+            end
+            record_command_metrics(message, total_duration, result)
           end
           if result && context.decrypt?
             result = result.maybe_decrypt(context)
@@ -208,7 +219,85 @@ module Mongo
         end
       end
 
-      def serialize(message, context, buffer = BSON::ByteBuffer.new)
+      # Records the duration of a command in the client's metrics, if
+      # metrics collection is enabled.
+      #
+      # @param [ Protocol::Message ] message The message sent.
+      # @param [ Float ] duration The duration of the command.
+      # @param [ Protocol::Message | nil | false ] result The reply, nil if
+      #   the message does not expect one, or false if sending the message
+      #   or receiving its reply raised an exception.
+      def record_command_metrics(message, duration, result)
+        metrics = monitoring.metrics
+        return unless metrics
+
+        succeeded = if result
+          document = result.documents.first
+          !(document && (document['ok'] && document['ok'] != 1 || document.key?('$err')))
+        else
+          result.nil?
+        end
+        metrics.record_command(message.command_name, address, duration, succeeded)
+      end
+
+      # Serializes the message into a list of buffers to be written to the
+      # socket in order.
+      #
+      # The message is serialized exactly once. Uncompressed messages are
+      # serialized into one buffer per OP_MSG section, so that large bulk
+      # writes with document sequences are never concatenated into a single
+      # buffer (nor copied into a single String) in their entirety.
+      #
+      # Messages that may be compressed are serialized into a single buffer
+      # whose contents are then compressed directly. Messages smaller than
+      # the :compression_threshold option are sent uncompressed, since the
+      # cost of compressing them exceeds the savings in bytes sent.
+      #
+      # RUBY-2234: The size of the uncompressed message is checked against
+      # the maximum message size prior to compression. This is to avoid the
+      # case where the user performs a bulk write larger than the limit
+      # which, when compressed, becomes smaller than the limit: the server
+      # would reject such a message because the uncompressed operation
+      # exceeds the maximum size.
+      #
+      # @return [ Array<String> ] The serialized message.
+      def serialize_segments(message, context)
+        max_bson_size = max_bson_size_for(message, context)
+        compressed_message = message.maybe_compress(compressor,
+          options[:zlib_compression_level], options[:zstd_compression_level])
+
+        if compressed_message.equal?(message)
+          segments = message.serialize_segments(max_bson_size, MAX_BSON_COMMAND_OVERHEAD)
+          check_message_size!(segments.sum(&:bytesize))
+          return segments
+        end
+
+        buffer = message.serialize(BSON::ByteBuffer.new, max_bson_size, MAX_BSON_COMMAND_OVERHEAD)
+        check_message_size!(buffer.length)
+        if (threshold = options[:compression_threshold]) && buffer.length < threshold
+          return [buffer.to_s]
+        end
+
+        [compressed_message.serialize_from(buffer).to_s]
+      end
+
+      # Adds the deadline of the operation, if it has one, to the options
+      # for reading the reply.
+      def with_deadline(options, context)
+        if deadline = context&.deadline
+          options.merge(deadline: deadline)
+        else
+          options
+        end
+      end
+
+      def check_message_size!(size)
+        if max_message_size && size > max_message_size
+          raise Error::MaxMessageSize.new(max_message_size)
+        end
+      end
+
+      def max_bson_size_for(message, context)
         # Driver specifications only mandate the fixed 16MiB limit for
         # serialized BSON documents. However, the server returns its
         # active serialized BSON document size limit in the hello response,
@@ -231,42 +320,7 @@ module Mongo
           end
         end
 
-        # RUBY-2234: It is necessary to check that the message size does not
-        # exceed the maximum bson object size before compressing and serializing
-        # the final message.
-        #
-        # This is to avoid the case where the user performs a bulk write
-        # larger than 16MiB which, when compressed, becomes smaller than 16MiB.
-        # If the driver does not split the bulk writes prior to compression,
-        # the entire operation will be sent to the server, which will raise an
-        # error because the uncompressed operation exceeds the maximum bson size.
-        #
-        # To address this problem, we serialize the message prior to compression
-        # and raise an exception if the serialized message exceeds the maximum
-        # bson size.
-        if max_message_size
-          # Create a separate buffer that contains the un-compressed message
-          # for the purpose of checking its size. Write any pre-existing contents
-          # from the original buffer into the temporary one.
-          temp_buffer = BSON::ByteBuffer.new
-
-          # TODO: address the fact that this line mutates the buffer.
-          temp_buffer.put_bytes(buffer.get_bytes(buffer.length))
-
-          message.serialize(temp_buffer, max_bson_size, MAX_BSON_COMMAND_OVERHEAD)
-          if temp_buffer.length > max_message_size
-            raise Error::MaxMessageSize.new(max_message_size)
-          end
-        end
-
-        # RUBY-2335: When the un-compressed message is smaller than the maximum
-        # bson size limit, the message will be serialized twice. The operations
-        # layer should be refactored to allow compression on an already-
-        # serialized message.
-        final_message = message.maybe_compress(compressor, options[:zlib_compression_level])
-        final_message.serialize(buffer, max_bson_size, MAX_BSON_COMMAND_OVERHEAD)
-
-        buffer
+        max_bson_size
       end
     end
   end
@@ -37,6 +37,10 @@ module Mongo
       # @since 2.9.0
       DEFAULT_MIN_SIZE = 0.freeze
 
+      # The default maximum number of connections that can be connecting
+      # at any given time.
+      DEFAULT_MAX_CONNECTING = 2.freeze
+
       # The default timeout, in seconds, to wait for a connection.
       #
       # This timeout applies while in flow threads are waiting for background
@@ -75,6 +79,9 @@ module Mongo
       #   are given, their values must be identical.
       # @option options [ Float ] :max_idle_time The time, in seconds,
       #   after which idle connections should be closed by the pool.
+      # @option options [ Integer ] :max_connecting The maximum number of
+      #   connections that can be established concurrently, by threads
+      #   checking out connections and by the populator combined.
       # Note: Additionally, options for connections created by this pool should
       #   be included in the options passed here, and they will be forwarded to
       #   any connections created by the pool.
@@ -103,6 +110,9 @@ module Mongo
         then
           raise ArgumentError, "Cannot have min size #{options[:min_size]} exceed max size #{options[:max_size]}"
         end
+        if options[:max_connecting] && options[:max_connecting] <= 0
+          raise ArgumentError, "Max connecting must be positive: #{options[:max_connecting]}"
+        end
         if options[:wait_queue_timeout]
           options[:wait_timeout] ||= options[:wait_queue_timeout]
         end
@@ -127,10 +137,16 @@ module Mongo
         # must do so under this lock.
         @lock = Mutex.new
 
-        # Condition variable broadcast when a connection is added to
+        # Condition variable signaled when a connection is added to
         # @available_connections, to wake up any threads waiting for an
-        # available connection when pool is at max size
-        @available_semaphore = Semaphore.new
+        # available connection when pool is at max size. It is used with
+        # @lock, so that checking for an available connection and starting
+        # to wait for one happen atomically.
+        @available_condition = ConditionVariable.new
+
+        # Number of threads waiting on @available_condition. Used to avoid
+        # signaling the condition variable when no thread is waiting.
+        @waiting_count = 0
 
         # Background thread reponsible for maintaining the size of
         # the pool to at least min_size
@@ -170,6 +186,15 @@ module Mongo
         @min_size ||= options[:min_size] || DEFAULT_MIN_SIZE
       end
 
+      # Get the maximum number of connections that can be connecting, i.e.
+      # performing the TCP connect, TLS and connection handshakes and
+      # authentication, at the same time.
+      #
+      # @return [ Integer ] The maximum number of connecting connections.
+      def max_connecting
+        @max_connecting ||= options[:max_connecting] || DEFAULT_MAX_CONNECTING
+      end
+
       # The time to wait, in seconds, for a connection to become available.
       #
       # @return [ Float ] The queue wait timeout.
@@ -233,6 +258,20 @@ module Mongo
         end
       end
 
+      # Number of connections currently checked out of the pool, i.e. the
+      # number of operations in progress on the server.
+      #
+      # The count is read without acquiring the pool lock, since it is used
+      # as a load estimate during server selection; it may therefore be
+      # slightly out of date.
+      #
+      # @return [ Integer ] Number of checked out connections.
+      #
+      # @api private
+      def checked_out_count
+        @checked_out_connections.length
+      end
+
       # Whether the pool has been closed.
       #
       # @return [ true | false ] Whether the pool is closed.
@@ -271,13 +310,17 @@ module Mongo
       # caller is finished using the connection, the connection should be
       # checked back in via the check_in method.
       #
+      # @param [ Float | nil ] timeout The time, in seconds, remaining until
+      #   the deadline of the operation the connection is checked out for.
+      #   If it is shorter than the wait timeout, it limits the wait.
+      #
       # @return [ Mongo::Server::Connection ] The checked out connection.
       # @raise [ Error::PoolClosedError ] If the pool has been closed.
       # @raise [ Timeout::Error ] If the connection pool is at maximum size
       #   and remains so for longer than the wait timeout.
       #
       # @since 2.9.0
-      def check_out(service_id: nil)
+      def check_out(service_id: nil, timeout: nil)
         check_invariants
 
         publish_cmap_event(
@@ -294,121 +337,173 @@ module Mongo
           raise Error::PoolClosedError.new(@server.address, self)
         end
 
-        deadline = Utils.monotonic_time + wait_timeout
+        start = Utils.monotonic_time
+        wait_time = if timeout && timeout < wait_timeout
+          timeout
+        else
+          wait_timeout
+        end
+        deadline = start + wait_time
         pid = Process.pid
         connection = nil
-        # It seems that synchronize sets up its own loop, thus a simple break
-        # is insufficient to break the outer loop
-        catch(:done) do
-          loop do
-            # Lock must be taken on each iteration, rather for the method
-            # overall, otherwise other threads will not be able to check in
-            # a connection while this thread is waiting for one.
+        # Whether the connection was taken from the available connections
+        # (and hence is already connected and counted as checked out).
+        reused = false
+        # Connections found to be unusable while looking for an available
+        # one. They are disconnected after the lock is released.
+        discarded = []
+        timeout_msg = nil
+
+        loop do
+          begin
+            # The lock is held for the entire check out, except while waiting
+            # for a connection to become available: waiting on the condition
+            # variable releases the lock, permitting other threads to check in
+            # connections. On the fast path, where an available connection
+            # exists, the lock is therefore acquired exactly once.
             @lock.synchronize do
-              until @available_connections.empty?
-                connection = next_available_connection(service_id: service_id)
-
-                if connection.pid != pid
-                  log_warn("Detected PID change - Mongo client should have been reconnected (old pid #{connection.pid}, new pid #{pid}")
-                  connection.disconnect!(reason: :stale)
-                  @populate_semaphore.signal
-                  next
+              loop do
+                until @available_connections.empty?
+                  candidate = next_available_connection(service_id: service_id)
+
+                  if candidate.pid != pid
+                    log_warn("Detected PID change - Mongo client should have been reconnected (old pid #{candidate.pid}, new pid #{pid}")
+                    discarded << [candidate, :stale]
+                    next
+                  end
+
+                  if candidate.generation != generation
+                    # Stale connections should be disconnected in the clear
+                    # method, but if any don't, check again here
+                    discarded << [candidate, :stale]
+                    next
+                  end
+
+                  if max_idle_time && candidate.last_checkin &&
+                    Time.now - candidate.last_checkin > max_idle_time
+                  then
+                    discarded << [candidate, :idle]
+                    next
+                  end
+
+                  connection = candidate
+                  reused = true
+                  @checked_out_connections << connection
+                  break
                 end
-
-                if connection.generation != generation
-                  # Stale connections should be disconnected in the clear
-                  # method, but if any don't, check again here
-                  connection.disconnect!(reason: :stale)
-                  @populate_semaphore.signal
-                  next
+                break if connection
+
+                if service_id
+                  # If we need a connection to a particular service, we can't
+                  # create one if we don't already have one, but we can wait
+                  # for an in-progress operation to return such a connection
+                  # to the pool, or for the populator to create a suitable
+                  # connection.
+                else
+                  # If we are below pool capacity, create a new connection,
+                  # unless max_connecting connections are already being
+                  # established. In that case wait for one of them to
+                  # become available, or for a connecting slot to free up.
+                  if unsynchronized_size < max_size &&
+                    @pending_connections.length < max_connecting
+                  then
+                    connection = create_connection
+                    @pending_connections << connection
+                    break
+                  end
                 end
 
-                if max_idle_time && connection.last_checkin &&
-                  Time.now - connection.last_checkin > max_idle_time
-                then
-                  connection.disconnect!(reason: :idle)
-                  @populate_semaphore.signal
-                  next
+                wait = deadline - Utils.monotonic_time
+                if wait <= 0
+                  service_id_msg = if service_id
+                    " for service #{service_id}"
+                  else
+                    ''
+                  end
+
+                  timeout_msg = "Timed out attempting to check out a connection " +
+                    "from pool for #{@server.address}#{service_id_msg} after #{wait_time} sec. " +
+                    "Connections in pool: #{@available_connections.length} available, " +
+                    "#{@checked_out_connections.length} checked out, " +
+                    "#{@pending_connections.length} pending " +
+                    "(max size: #{max_size})"
+                  break
                 end
 
-                @pending_connections << connection
-                throw(:done)
-              end
-
-              if service_id
-                # If we need a connection to a particular service, we can't
-                # create one if we don't already have one, but we can wait
-                # for an in-progress operation to return such a connection
-                # to the pool, or for the populator to create a suitable
-                # connection.
-              else
-                # If we are below pool capacity, create a new connection.
-                #
-                # Ruby does not allow a thread to lock a mutex which it already
-                # holds.
-                if unsynchronized_size < max_size
-                  connection = create_connection
-                  @pending_connections << connection
-                  throw(:done)
+                # Disconnect the unusable connections found so far before
+                # waiting, rather than after the wait completes.
+                break unless discarded.empty?
+
+                # When running under a fiber scheduler, this wait suspends
+                # only the current fiber (Mutex and ConditionVariable are
+                # fiber-aware as of Ruby 3.0), so that many fibers of one
+                # thread can share the pool.
+                @waiting_count += 1
+                begin
+                  @available_condition.wait(@lock, wait)
+                ensure
+                  @waiting_count -= 1
                 end
               end
             end
-
-            wait = deadline - Utils.monotonic_time
-            if wait <= 0
-              publish_cmap_event(
-                Monitoring::Event::Cmap::ConnectionCheckOutFailed.new(
-                  @server.address,
-                  Monitoring::Event::Cmap::ConnectionCheckOutFailed::TIMEOUT,
-                ),
-              )
-
-              msg = @lock.synchronize do
-                service_id_msg = if service_id
-                  " for service #{service_id}"
-                else
-                  ''
-                end
-
-                "Timed out attempting to check out a connection " +
-                  "from pool for #{@server.address}#{service_id_msg} after #{wait_timeout} sec. " +
-                  "Connections in pool: #{@available_connections.length} available, " +
-                  "#{@checked_out_connections.length} checked out, " +
-                  "#{@pending_connections.length} pending " +
-                  "(max size: #{max_size})"
-              end
-              raise Error::ConnectionCheckOutTimeout.new(msg, address: @server.address)
+          ensure
+            discarded.each do |candidate, reason|
+              candidate.disconnect!(reason: reason)
+              @populate_semaphore.signal
             end
-            @available_semaphore.wait(wait)
+            discarded.clear
           end
-        end
 
-        begin
-          connect_connection(connection)
-        rescue Exception
-          # Handshake or authentication failed
-          @lock.synchronize do
-            @pending_connections.delete(connection)
-          end
-          @populate_semaphore.signal
+          break if connection || timeout_msg
+        end
 
+        if timeout_msg
           publish_cmap_event(
             Monitoring::Event::Cmap::ConnectionCheckOutFailed.new(
               @server.address,
-              Monitoring::Event::Cmap::ConnectionCheckOutFailed::CONNECTION_ERROR
+              Monitoring::Event::Cmap::ConnectionCheckOutFailed::TIMEOUT,
             ),
           )
-          raise
+          raise Error::ConnectionCheckOutTimeout.new(timeout_msg, address: @server.address)
         end
 
-        @lock.synchronize do
-          @checked_out_connections << connection
-          @pending_connections.delete(connection)
+        unless reused
+          begin
+            connect_connection(connection)
+          rescue Exception
+            # Handshake or authentication failed
+            @lock.synchronize do
+              @pending_connections.delete(connection)
+              signal_available
+            end
+            @populate_semaphore.signal
+
+            publish_cmap_event(
+              Monitoring::Event::Cmap::ConnectionCheckOutFailed.new(
+                @server.address,
+                Monitoring::Event::Cmap::ConnectionCheckOutFailed::CONNECTION_ERROR
+              ),
+            )
+            raise
+          end
+
+          @lock.synchronize do
+            @checked_out_connections << connection
+            @pending_connections.delete(connection)
+            # A connecting slot was freed.
+            signal_available
+            if unsynchronized_size < min_size
+              @populate_semaphore.signal
+            end
+          end
         end
 
         publish_cmap_event(
           Monitoring::Event::Cmap::ConnectionCheckedOut.new(@server.address, connection.id, self),
         )
+        if metrics = monitoring.metrics
+          metrics.record_check_out(@server.address, Utils.monotonic_time - start)
+        end
 
         if Lint.enabled?
           unless connection.connected?
@@ -431,6 +526,11 @@ module Mongo
       def check_in(connection)
         check_invariants
 
+        # Reason to disconnect the connection with, if it should not be
+        # returned to the pool. The connection is disconnected after the
+        # lock is released.
+        disconnect_reason = nil
+
         @lock.synchronize do
           unless connection.connection_pool == self
             raise ArgumentError, "Trying to check in a connection which was not checked out by this pool: #{connection} checked out from pool #{connection.connection_pool} (for #{self})"
@@ -446,35 +546,41 @@ module Mongo
           # Threads that begin waiting after this method completes (with
           # the exception) should be fine.
 
+          # The event is published while holding the lock so that it
+          # precedes the checked out event of any thread which subsequently
+          # checks out this connection.
           @checked_out_connections.delete(connection)
           publish_cmap_event(
             Monitoring::Event::Cmap::ConnectionCheckedIn.new(@server.address, connection.id, self)
           )
-
-          if connection.error?
-            connection.disconnect!(reason: :error)
-            return
+          if metrics = monitoring.metrics
+            metrics.record_check_in(@server.address)
           end
 
-          if closed?
-            connection.disconnect!(reason: :pool_closed)
-            return
-          end
-
-          if connection.closed?
+          if connection.error?
+            disconnect_reason = :error
+          elsif closed?
+            disconnect_reason = :pool_closed
+          elsif connection.closed?
             # Connection was closed - for example, because it experienced
             # a network error. Nothing else needs to be done here.
             @populate_semaphore.signal
           elsif connection.generation != @generation
-            connection.disconnect!(reason: :stale)
-            @populate_semaphore.signal
+            disconnect_reason = :stale
           else
             connection.record_checkin!
             @available_connections << connection
 
             # Wake up only one thread waiting for an available connection,
             # since only one connection was checked in.
-            @available_semaphore.signal
+            signal_available
+          end
+        end
+
+        if disconnect_reason
+          connection.disconnect!(reason: disconnect_reason)
+          if disconnect_reason == :stale
+            @populate_semaphore.signal
           end
         end
       ensure
@@ -623,13 +729,17 @@ module Mongo
       #     connection.read
       #   end
       #
+      # @param [ Float | nil ] timeout The time, in seconds, remaining until
+      #   the deadline of the operation, which limits the wait for a
+      #   connection.
+      #
       # @return [ Object ] The result of the block.
       #
       # @since 2.0.0
-      def with_connection(service_id: nil)
+      def with_connection(service_id: nil, timeout: nil)
         raise_if_closed!
 
-        connection = check_out(service_id: service_id)
+        connection = check_out(service_id: service_id, timeout: timeout)
         yield(connection)
       ensure
         if connection
@@ -688,7 +798,8 @@ module Mongo
       end
 
       # Creates and adds a connection to the pool, if the pool's size is below
-      # min_size. Retries once if a socket-related error is encountered during
+      # min_size and fewer than max_connecting connections are being
+      # established. Retries once if a socket-related error is encountered during
       # this process and raises if a second error or a non socket-related error occurs.
       #
       # Used by the pool populator background thread.
@@ -714,10 +825,27 @@ module Mongo
       rescue Error::AuthError, Error
         # wake up one thread waiting for connections, since one could not
         # be created here, and can instead be created in flow
-        @available_semaphore.signal
+        @lock.synchronize do
+          signal_available
+        end
         raise
       end
 
+      # Returns the number of connections that the populator may establish
+      # concurrently right now, which is the number of connections needed to
+      # reach min_size, limited by the number of free connecting slots.
+      #
+      # @return [ Integer ] Number of connections to create.
+      #
+      # @api private
+      def populate_count
+        return 0 if closed?
+
+        @lock.synchronize do
+          [min_size - unsynchronized_size, max_connecting - @pending_connections.length].min
+        end
+      end
+
       # Finalize the connection pool for garbage collection.
       #
       # @param [ List<Mongo::Connection> ] available_connections The available connections.
@@ -745,6 +873,14 @@ module Mongo
 
       private
 
+      # Wakes up one thread waiting for an available connection, if any.
+      # Must be called while holding the lock.
+      def signal_available
+        if @waiting_count > 0
+          @available_condition.signal
+        end
+      end
+
       def next_available_connection(service_id: nil)
         if service_id
           conn = @available_connections.detect do |conn|
@@ -775,7 +911,9 @@ module Mongo
         connection = nil
 
         @lock.synchronize do
-          if !closed? && unsynchronized_size < min_size
+          if !closed? && unsynchronized_size < min_size &&
+            @pending_connections.length < max_connecting
+          then
             connection = create_connection
             @pending_connections << connection
           else
@@ -789,6 +927,7 @@ module Mongo
           @lock.synchronize do
             @pending_connections.delete(connection)
           end
+          @populate_semaphore.signal
           raise
         end
 
@@ -797,7 +936,7 @@ module Mongo
           @pending_connections.delete(connection)
 
           # wake up one thread waiting for connections, since one was created
-          @available_semaphore.signal
+          signal_available
         end
 
         true
@@ -817,12 +956,16 @@ module Mongo
       # Attempts to connect (handshake and auth) the connection. If an error is
       # encountered, closes the connection and raises the error.
       def connect_connection(connection)
+        start = Utils.monotonic_time
         begin
           connection.connect!
         rescue Exception
           connection.disconnect!(reason: :error)
           raise
         end
+        if metrics = monitoring.metrics
+          metrics.record_connection_created(@server.address, Utils.monotonic_time - start)
+        end
       rescue Error::SocketError, Error::SocketTimeoutError => exc
         @server.unknown!(
           generation: exc.generation,
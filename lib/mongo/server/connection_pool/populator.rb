@@ -46,7 +46,7 @@ module Mongo
         throw(:done) if @pool.closed?
 
         begin
-          unless @pool.populate
+          unless populate
             @pool.populate_semaphore.wait
           end
         rescue Error::AuthError, Error => e
@@ -56,6 +56,51 @@ module Mongo
           @pool.populate_semaphore.wait(5)
         end
       end
+
+      # Populates the pool, establishing up to the pool's max_connecting
+      # connections concurrently.
+      #
+      # @return [ true | false ] Whether the pool should be populated again.
+      # @raise [ Error::AuthError, Error ] The error encountered, if no
+      #   connection could be established.
+      def populate
+        count = @pool.populate_count
+        if count <= 1
+          return @pool.populate
+        end
+
+        threads = Array.new(count - 1) do
+          Thread.new do
+            Thread.current.report_on_exception = false
+            @pool.populate
+          end
+        end
+
+        results = []
+        error = nil
+        begin
+          results << @pool.populate
+        rescue Error::AuthError, Error => e
+          error = e
+        end
+        threads.each do |thread|
+          begin
+            results << thread.value
+          rescue Error::AuthError, Error => e
+            error ||= e
+          end
+        end
+
+        # If any connection was established, populate again right away;
+        # a persistent error is raised by the next call.
+        if results.include?(true)
+          true
+        elsif error
+          raise error
+        else
+          false
+        end
+      end
     end
   end
 end
@@ -211,11 +211,16 @@ module Mongo
       #   command took to complete.
       # @param [ Float ] average_round_trip_time The moving average time (sec)
       #   the ismaster call took to complete.
+      # @param [ Float ] min_round_trip_time The minimum of the recent
+      #   times (sec) the hello command took to complete.
+      # @param [ Float ] p90_round_trip_time The 90th percentile of the
+      #   recent times (sec) the hello command took to complete.
       # @param [ true | false ] load_balancer Whether the server is a load
       #   balancer.
       #
       # @api private
       def initialize(address, config = {}, average_round_trip_time: nil,
+        min_round_trip_time: nil, p90_round_trip_time: nil,
         load_balancer: false
       )
         @address = address
@@ -223,6 +228,8 @@ module Mongo
         @load_balancer = !!load_balancer
         @features = Features.new(wire_versions, me || @address.to_s)
         @average_round_trip_time = average_round_trip_time
+        @min_round_trip_time = min_round_trip_time
+        @p90_round_trip_time = p90_round_trip_time
         @last_update_time = Time.now.freeze
         @last_update_monotime = Utils.monotonic_time
 
@@ -301,6 +308,14 @@ module Mongo
       # @return [ Float ] The moving average time the hello call took to complete.
       attr_reader :average_round_trip_time
 
+      # @return [ Float | nil ] The minimum of the times the recent hello
+      #   calls took to complete.
+      attr_reader :min_round_trip_time
+
+      # @return [ Float | nil ] The 90th percentile of the times the recent
+      #   hello calls took to complete.
+      attr_reader :p90_round_trip_time
+
       # Returns whether this server is an arbiter, per the SDAM spec.
       #
       # @example Is the server an arbiter?
@@ -214,8 +214,11 @@ module Mongo
         @sdam_mutex.synchronize do
           old_description = server.description
 
+          averager = server.round_trip_time_averager
           new_description = Description.new(server.address, result,
-            average_round_trip_time: server.round_trip_time_averager.average_round_trip_time
+            average_round_trip_time: averager.average_round_trip_time,
+            min_round_trip_time: averager.min_round_trip_time,
+            p90_round_trip_time: averager.p90_round_trip_time,
           )
 
           server.cluster.run_sdam_flow(server.description, new_description, awaited: awaited)
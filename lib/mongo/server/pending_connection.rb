@@ -145,7 +145,7 @@ module Mongo
           end
         end
 
-        post_handshake(doc, @server.round_trip_time_averager.average_round_trip_time)
+        post_handshake(doc, @server.round_trip_time_averager)
 
         doc
       end
@@ -195,7 +195,7 @@ module Mongo
       #
       # @return [ Server::Description ] The server description calculated from
       #   the handshake response for this particular connection.
-      def post_handshake(response, average_rtt)
+      def post_handshake(response, averager)
         if response["ok"] == 1
           # Auth mechanism is entirely dependent on the contents of
           # hello response *for this connection*.
@@ -213,7 +213,9 @@ module Mongo
 
         @description = Description.new(
           address, response,
-          average_round_trip_time: average_rtt,
+          average_round_trip_time: averager.average_round_trip_time,
+          min_round_trip_time: averager.min_round_trip_time,
+          p90_round_trip_time: averager.p90_round_trip_time,
           load_balancer: server.load_balancer?,
         ).tap do |new_description|
           @server.cluster.run_sdam_flow(@server.description, new_description)
@@ -25,14 +25,32 @@ module Mongo
       RTT_WEIGHT_FACTOR = 0.2.freeze
       private_constant :RTT_WEIGHT_FACTOR
 
+      # The number of most recent round trip times from which the minimum
+      # and 90th percentile round trip times are calculated.
+      RTT_WINDOW_SIZE = 10
+      private_constant :RTT_WINDOW_SIZE
+
       def initialize
         @last_round_trip_time = nil
         @average_round_trip_time = nil
+        @min_round_trip_time = nil
+        @p90_round_trip_time = nil
+        @samples = []
+        # Round trip times are measured by the monitor and by connections
+        # performing handshakes, in different threads.
+        @lock = Mutex.new
       end
 
       attr_reader :last_round_trip_time
       attr_reader :average_round_trip_time
 
+      # @return [ Float | nil ] The minimum of the recent round trip times.
+      attr_reader :min_round_trip_time
+
+      # @return [ Float | nil ] The 90th percentile of the recent round trip
+      #   times.
+      attr_reader :p90_round_trip_time
+
       def measure
         start = Utils.monotonic_time
         begin
@@ -50,8 +68,11 @@ module Mongo
         # because it is used in the heartbeat failed SDAM event,
         # but we must not update the round trip time recorded in the server.
         unless exc
-          @last_round_trip_time = last_round_trip_time
-          update_average_round_trip_time
+          @lock.synchronize do
+            @last_round_trip_time = last_round_trip_time
+            update_average_round_trip_time
+            update_round_trip_time_window
+          end
         end
 
         if exc
@@ -71,6 +92,20 @@ module Mongo
           last_round_trip_time
         end
       end
+
+      # Unlike the moving average, which reacts to latency changes over many
+      # heartbeats, the window statistics reflect only the most recent round
+      # trip times: the minimum approximates the network latency to the
+      # server and the 90th percentile exposes jitter and degradation.
+      def update_round_trip_time_window
+        @samples << last_round_trip_time
+        @samples.shift if @samples.length > RTT_WINDOW_SIZE
+
+        sorted = @samples.sort
+        @min_round_trip_time = sorted.first
+        # Nearest-rank percentile.
+        @p90_round_trip_time = sorted[(sorted.length * 0.9).ceil - 1]
+      end
     end
   end
 end
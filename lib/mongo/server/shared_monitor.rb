@@ -0,0 +1,317 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the 'License');
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an 'AS IS' BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  class Server
+
+    # Monitors a server on behalf of the servers of all clients which were
+    # created with the :shared_monitoring option and the same monitoring
+    # related options, so that a process using many clients with the same
+    # deployment runs one monitoring thread and one set of monitoring
+    # connections per server rather than one per client.
+    #
+    # The shared monitor runs a regular Monitor, acting as the server and
+    # the cluster of that monitor: the description produced by each check
+    # is delivered to the cluster of every subscribed server. A server which
+    # subscribes to a shared monitor that has already checked its server
+    # receives the last description right away, without waiting for a check,
+    # and servers that are data-bearing have their connection pool created
+    # so that the pool is populated up to its minimum size.
+    #
+    # Server heartbeat events are not published for shared monitors.
+    #
+    # @api private
+    class SharedMonitor
+      include Loggable
+
+      # The options which determine how a server is monitored. Servers
+      # share a monitor only if these options, and the address, are equal.
+      KEY_OPTIONS = %i(
+        app_name
+        compressors
+        connect_timeout
+        heartbeat_interval
+        platform
+        server_api
+        socket_timeout
+        ssl
+        ssl_ca_cert
+        ssl_ca_cert_object
+        ssl_ca_cert_string
+        ssl_cert
+        ssl_cert_object
+        ssl_cert_string
+        ssl_key
+        ssl_key_object
+        ssl_key_pass_phrase
+        ssl_key_string
+        ssl_verify
+        ssl_verify_certificate
+        ssl_verify_hostname
+        ssl_verify_ocsp_endpoint
+        wrapping_libraries
+        zlib_compression_level
+        zstd_compression_level
+      ).freeze
+
+      @lock = Mutex.new
+
+      # Map from monitor key to shared monitor.
+      @monitors = {}
+
+      class << self
+
+        # Subscribes the server to the shared monitor for its address and
+        # options, creating the shared monitor if there is none.
+        #
+        # @param [ Server ] server The server.
+        # @param [ Hash ] options The monitor options.
+        #
+        # @return [ SharedMonitor ] The shared monitor.
+        def subscribe(server, options)
+          key = [ server.address.seed ] + KEY_OPTIONS.map { |name| options[name] }
+          @lock.synchronize do
+            (@monitors[key] ||= new(key, server.address, options)).tap do |monitor|
+              monitor.send(:add, server)
+            end
+          end
+        end
+
+        # Unsubscribes the server from the shared monitor, stopping the
+        # monitor if no other server is subscribed to it.
+        #
+        # @param [ SharedMonitor ] monitor The shared monitor.
+        # @param [ Server ] server The server.
+        def unsubscribe(monitor, server)
+          stop = @lock.synchronize do
+            if monitor.send(:remove, server) && @monitors[monitor.key].equal?(monitor)
+              @monitors.delete(monitor.key)
+              true
+            end
+          end
+          monitor.monitor.stop! if stop
+        end
+
+        # @return [ Array<SharedMonitor> ] The shared monitors.
+        def monitors
+          @lock.synchronize do
+            @monitors.values
+          end
+        end
+      end
+
+      # @param [ Array ] key The key identifying the monitor.
+      # @param [ Address ] address The address of the monitored server.
+      # @param [ Hash ] options The monitor options.
+      def initialize(key, address, options)
+        @key = key
+        @address = address
+        @options = options
+        @scan_semaphore = DistinguishingSemaphore.new
+        @round_trip_time_averager = RoundTripTimeAverager.new
+        @description = Description.new(address, {})
+        @servers = []
+        @servers_lock = Mutex.new
+        @monitor = Monitor.new(self, Event::Listeners.new,
+          Monitoring.new(monitoring: false), options)
+      end
+
+      # @return [ Array ] The key identifying the monitor.
+      attr_reader :key
+
+      # @return [ Address ] The address of the monitored server.
+      attr_reader :address
+
+      # @return [ Hash ] The monitor options.
+      attr_reader :options
+
+      # @return [ Semaphore ] Semaphore to signal to request an immediate
+      #   check of the server.
+      attr_reader :scan_semaphore
+
+      # @return [ RoundTripTimeAverager ] Round trip time averager object.
+      attr_reader :round_trip_time_averager
+
+      # @return [ Description ] The description produced by the last check.
+      attr_reader :description
+
+      # @return [ Monitor ] The monitor performing the checks.
+      attr_reader :monitor
+
+      # @return [ Array<Server> ] The subscribed servers.
+      def servers
+        @servers_lock.synchronize do
+          @servers.dup
+        end
+      end
+
+      # The monitor reports its descriptions to the cluster of the server
+      # it monitors, which is the shared monitor itself.
+      #
+      # @return [ SharedMonitor ] self.
+      def cluster
+        self
+      end
+
+      # Delivers the description produced by a check to the clusters of
+      # all subscribed servers.
+      #
+      # @param [ Description ] previous_desc The previous description.
+      # @param [ Description ] updated_desc The new description.
+      # @param [ Hash ] options The SDAM flow options.
+      def run_sdam_flow(previous_desc, updated_desc, options = {})
+        @description = updated_desc
+        servers.each do |server|
+          deliver(server, updated_desc, options)
+        end
+      end
+
+      # Delivers the last description, if the server has been checked, to
+      # the cluster of the server, in a background thread since the caller
+      # may be running the SDAM flow of that cluster.
+      #
+      # @param [ Server ] server The server.
+      def deliver_last_description(server)
+        description = @description
+        return if description.config.empty?
+
+        Thread.new do
+          deliver(server, description)
+        end
+      end
+
+      private
+
+      def add(server)
+        @servers_lock.synchronize do
+          @servers << server unless @servers.include?(server)
+        end
+      end
+
+      # Returns whether no servers remain subscribed.
+      def remove(server)
+        @servers_lock.synchronize do
+          @servers.delete(server)
+          @servers.empty?
+        end
+      end
+
+      def deliver(server, description, options = {})
+        return unless server.connected?
+
+        server.cluster.run_sdam_flow(server.description, description, options)
+        if server.description.data_bearing? && server.connected?
+          # Creating the pool starts populating it to its minimum size.
+          server.pool
+        end
+      rescue => e
+        log_warn("Error updating the description of #{server.address} in #{server.cluster.summary}: #{e.class}: #{e}")
+      end
+
+      # Maintains the subscription of a server to a shared monitor.
+      #
+      # Provides the interface of Monitor used by Server, so that servers
+      # using shared monitoring are started, stopped and scanned like
+      # servers with their own monitor.
+      #
+      # @api private
+      class Subscription
+
+        # @param [ Server ] server The server.
+        # @param [ Hash ] options The monitor options.
+        def initialize(server, options)
+          @server = server
+          @options = options
+          @lock = Mutex.new
+          @shared_monitor = nil
+        end
+
+        # @return [ Server ] The subscribed server.
+        attr_reader :server
+
+        # @return [ Hash ] The monitor options.
+        attr_reader :options
+
+        # @return [ SharedMonitor | nil ] The shared monitor, if subscribed.
+        def shared_monitor
+          @lock.synchronize do
+            @shared_monitor
+          end
+        end
+
+        # Subscribes to the shared monitor and starts it if it is not
+        # already running.
+        def run!
+          shared_monitor = @lock.synchronize do
+            @shared_monitor ||= SharedMonitor.subscribe(server, options).tap do |monitor|
+              monitor.deliver_last_description(server)
+            end
+          end
+          shared_monitor.monitor.run!
+        end
+        alias :restart! :run!
+
+        # Unsubscribes from the shared monitor.
+        #
+        # @return [ true ] Always true.
+        def stop!
+          shared_monitor = @lock.synchronize do
+            @shared_monitor.tap do
+              @shared_monitor = nil
+            end
+          end
+          if shared_monitor
+            SharedMonitor.unsubscribe(shared_monitor, server)
+          end
+          true
+        end
+
+        # @return [ true | false ] Whether the shared monitor is running.
+        def running?
+          !!shared_monitor&.monitor&.running?
+        end
+
+        # @return [ Semaphore | nil ] Semaphore to signal to request an
+        #   immediate check of the server, if subscribed.
+        def scan_semaphore
+          shared_monitor&.scan_semaphore
+        end
+
+        def heartbeat_interval
+          options[:heartbeat_interval] || Monitor::DEFAULT_HEARTBEAT_INTERVAL
+        end
+
+        def scan!
+          shared_monitor&.monitor&.scan!
+        end
+
+        def stop_push_monitor!
+          shared_monitor&.monitor&.stop_push_monitor!
+        end
+
+        def connection
+          shared_monitor&.monitor&.connection
+        end
+
+        # @deprecated
+        def compressor
+          connection&.compressor
+        end
+      end
+    end
+  end
+end
@@ -162,23 +162,35 @@ module Mongo
       #   Deprecated and ignored.
       # @param [ Session | nil ] session Optional session to take into account
       #   for mongos pinning. Added in version 2.10.0.
+      # @param [ Float | nil ] timeout The time, in seconds, remaining until
+      #   the deadline of the operation the server is selected for. If it is
+      #   shorter than the server selection timeout, server selection fails
+      #   when it elapses.
       #
       # @return [ Mongo::Server ] A server matching the server preference.
       #
       # @raise [ Error::NoServerAvailable ] No server was found matching the
       #   specified preference / pinning requirement in the server selection
       #   timeout.
+      # @raise [ Error::TimeoutError ] No server was found before the
+      #   deadline of the operation.
       # @raise [ Error::LintError ] An unexpected condition was detected, and
       #   lint mode is enabled.
       #
       # @since 2.0.0
-      def select_server(cluster, ping = nil, session = nil)
+      def select_server(cluster, ping = nil, session = nil, timeout: nil)
         if cluster.topology.is_a?(Cluster::Topology::LoadBalanced)
           return cluster.servers.first
         end
 
         server_selection_timeout = cluster.options[:server_selection_timeout] || SERVER_SELECTION_TIMEOUT
 
+        # Whether the deadline of the operation, rather than the server
+        # selection timeout, limits server selection.
+        if operation_deadline = timeout && timeout < server_selection_timeout
+          server_selection_timeout = timeout
+        end
+
         # Special handling for zero timeout: if we have to select a server,
         # and the timeout is zero, fail immediately (since server selection
         # will take some non-zero amount of time in any case).
@@ -280,6 +292,9 @@ module Mongo
                 "with timeout=#{server_selection_timeout}, " +
                 "LT=#{local_threshold_with_cluster(cluster)}"
         msg += server_selection_diagnostic_message(cluster)
+        if operation_deadline
+          raise Error::TimeoutError, "#{msg} before the timeout_ms deadline"
+        end
         raise Error::NoServerAvailable.new(self, cluster, msg)
       rescue Error::NoServerAvailable => e
         if session && session.in_transaction? && !session.committing_transaction?
@@ -300,11 +315,15 @@ module Mongo
       def try_select_server(cluster)
         servers = suitable_servers(cluster)
 
-        # This list of servers may be ordered in a specific way
-        # by the selector (e.g. for secondary preferred, the first
-        # server may be a secondary and the second server may be primary)
-        # and we should take the first server here respecting the order
-        server = servers.first
+        server = if cluster.options[:server_selection_strategy] == :power_of_two_choices
+          less_loaded_server(preferred_servers(servers))
+        else
+          # This list of servers may be ordered in a specific way
+          # by the selector (e.g. for secondary preferred, the first
+          # server may be a secondary and the second server may be primary)
+          # and we should take the first server here respecting the order
+          servers.first
+        end
 
         if server
           if Lint.enabled?
@@ -375,6 +394,38 @@ module Mongo
 
       private
 
+      # Returns the suitable servers which are equally preferred by this
+      # selector, that is, the servers any of which may be selected.
+      #
+      # @param [ Array<Server> ] servers The suitable servers, in the order
+      #   of preference returned by #suitable_servers.
+      #
+      # @return [ Array<Server> ] The most preferred servers.
+      def preferred_servers(servers)
+        servers
+      end
+
+      # Picks two of the servers at random and returns the one with fewer
+      # operations in progress ("power of two choices").
+      #
+      # Compared to picking a random server, this steers operations away
+      # from servers which are overloaded or slow to respond, while avoiding
+      # sending all operations to the single least loaded server.
+      #
+      # @param [ Array<Server> ] servers The servers to choose from.
+      #
+      # @return [ Server | nil ] The selected server.
+      def less_loaded_server(servers)
+        return servers.first if servers.length < 2
+
+        first, second = servers.sample(2)
+        if second.operation_count < first.operation_count
+          second
+        else
+          first
+        end
+      end
+
       # Convert this server preference definition into a format appropriate
       #   for sending to a MongoDB server (i.e., as a command field).
       #
@@ -611,8 +662,7 @@ module Mongo
         msg = ''
         dead_monitors = []
         cluster.servers_list.each do |server|
-          thread = server.monitor.instance_variable_get('@thread')
-          if thread.nil? || !thread.alive?
+          unless server.monitor&.running?
             dead_monitors << server
           end
         end
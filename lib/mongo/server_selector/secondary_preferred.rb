@@ -105,6 +105,12 @@ module Mongo
         near_servers(secondaries(candidates)) + primary(candidates)
       end
 
+      # The primary is only selected if no secondary is suitable.
+      def preferred_servers(servers)
+        secondaries = servers.reject(&:primary?)
+        secondaries.empty? ? servers : secondaries
+      end
+
       def max_staleness_allowed?
         true
       end
@@ -38,8 +38,12 @@ module Mongo
 
       # The last time the server session was used.
       #
+      # @return [ Time ] The last time the session was used.
+      #
       # @since 2.5.0
-      attr_reader :last_use
+      def last_use
+        @last_use ||= Time.now - idle_time
+      end
 
       # The current transaction number.
       #
@@ -77,11 +81,23 @@ module Mongo
       # @example Set the last use field to now.
       #   server_session.set_last_use!
       #
-      # @return [ Time ] The last time the session was used.
+      # @return [ Float ] The monotonic time of the last use.
       #
       # @since 2.5.0
       def set_last_use!
-        @last_use = Time.now
+        # Wall clock time is only computed if #last_use is called, since
+        # the monotonic clock is cheaper to read.
+        @last_use = nil
+        @last_use_monotonic = Utils.monotonic_time
+      end
+
+      # Returns the time since the server session was last used.
+      #
+      # @return [ Float ] The idle time in seconds.
+      #
+      # @api private
+      def idle_time
+        Utils.monotonic_time - @last_use_monotonic
       end
 
       # The session id of this server session.
@@ -21,6 +21,12 @@ module Mongo
 
     # A pool of server sessions.
     #
+    # Sessions are kept in a stack, the most recently used session being
+    # checked out first. The mutex only guards pushing and popping
+    # sessions; sessions that are about to expire are discarded when they
+    # are checked out or in, and removed from the bottom of the stack by
+    # the cluster's periodic executor, which calls #execute.
+    #
     # @api private
     #
     # @since 2.5.0
@@ -76,16 +82,12 @@ module Mongo
       #
       # @since 2.5.0
       def checkout
-        @mutex.synchronize do
-          loop do
-            if @queue.empty?
-              return ServerSession.new
-            else
-              session = @queue.shift
-              unless about_to_expire?(session)
-                return session
-              end
-            end
+        loop do
+          session = @mutex.synchronize { @queue.pop }
+          if session.nil?
+            return ServerSession.new
+          elsif !about_to_expire?(session)
+            return session
           end
         end
       end
@@ -99,14 +101,27 @@ module Mongo
       #
       # @since 2.5.0
       def checkin(session)
-        @mutex.synchronize do
-          prune!
-          unless about_to_expire?(session)
-            @queue.unshift(session)
-          end
+        unless about_to_expire?(session)
+          @mutex.synchronize { @queue.push(session) }
         end
       end
 
+      # Remove the sessions that are about to expire from the pool.
+      #
+      # Called periodically by the cluster's periodic executor.
+      #
+      # @api private
+      def execute
+        prune!
+      end
+
+      # Does nothing; sessions are ended by #end_sessions when the cluster
+      # disconnects.
+      #
+      # @api private
+      def flush
+      end
+
       # End all sessions in the pool by sending the endSessions command to the server.
       #
       # @example End all sessions.
@@ -136,17 +151,20 @@ module Mongo
         logical_session_timeout = @cluster.logical_session_timeout
 
         if logical_session_timeout
-          idle_time_minutes = (Time.now - session.last_use) / 60
+          idle_time_minutes = session.idle_time / 60
           (idle_time_minutes + 1) >= logical_session_timeout
         end
       end
 
+      # The least recently used sessions are at the bottom of the stack.
       def prune!
-        while !@queue.empty?
-          if about_to_expire?(@queue[-1])
-            @queue.pop
-          else
-            break
+        @mutex.synchronize do
+          while !@queue.empty?
+            if about_to_expire?(@queue.first)
+              @queue.shift
+            else
+              break
+            end
           end
         end
       end
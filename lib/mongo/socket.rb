@@ -52,6 +52,11 @@ module Mongo
     # @api private
     WRITE_CHUNK_SIZE = 65536
 
+    # Buffers smaller than this size are combined into a single write.
+    #
+    # @api private
+    WRITE_COALESCE_SIZE = 16384
+
     # Initializes common socket attributes.
     #
     # @param [ Float ] timeout The socket timeout value.
@@ -288,15 +293,24 @@ module Mongo
       data = nil
 
       # If we want to read less than the buffer size, just allocate the
-      # memory that is necessary
-      if length < buf_size
+      # memory that is necessary. This buffer may be returned to the caller
+      # as is, therefore it must not be shared between reads.
+      #
+      # Otherwise the reply spans multiple reads and every chunk is copied
+      # into the destination string; in this case the chunk buffer is
+      # owned by the socket and reused across reads, which avoids
+      # allocating a short-lived chunk buffer for each large reply.
+      if length <= buf_size
         buf_size = length
+        # The binary encoding is important, otherwise Ruby performs encoding
+        # conversions of some sort during the write into the buffer which
+        # kills performance
+        buf = allocate_string(buf_size)
+        reusing_buffer = false
+      else
+        buf = reusable_read_buffer
+        reusing_buffer = true
       end
-
-      # The binary encoding is important, otherwise Ruby performs encoding
-      # conversions of some sort during the write into the buffer which
-      # kills performance
-      buf = allocate_string(buf_size)
       retrieved = 0
       begin
         while retrieved < length
@@ -309,7 +323,7 @@ module Mongo
           # If we read the entire wanted length in one operation,
           # return the data as is which saves one memory allocation and
           # one copy per read
-          if retrieved == 0 && chunk.length == length
+          if retrieved == 0 && chunk.length == length && !reusing_buffer
             return chunk
           end
 
@@ -322,7 +336,7 @@ module Mongo
           end
 
           # ... and we need to copy the chunks at this point
-          data[retrieved, chunk.length] = chunk
+          data << chunk
           retrieved += chunk.length
         end
       # As explained in https://ruby-doc.com/core-trunk/IO.html#method-c-select,
@@ -334,6 +348,21 @@ module Mongo
             raise Errno::ETIMEDOUT, "Took more than #{_timeout} seconds to receive data"
           end
         end
+        if Utils.fiber_scheduler
+          # Under a fiber scheduler, wait through the scheduler so that
+          # other fibers of this thread run while the reply is pending.
+          # Kernel.select would block the entire thread.
+          io = @socket.to_io
+          ready = if exc.is_a?(IO::WaitReadable)
+            io.wait_readable(select_timeout)
+          else
+            io.wait_writable(select_timeout)
+          end
+          unless ready
+            raise Errno::ETIMEDOUT, "Took more than #{_timeout} seconds to receive data (wait timed out)"
+          end
+          retry
+        end
         if exc.is_a?(IO::WaitReadable)
           select_args = [[@socket], nil, [@socket], select_timeout]
         else
@@ -375,6 +404,17 @@ module Mongo
       65536
     end
 
+    # Returns the chunk buffer owned by this socket, allocating it on
+    # first use.
+    #
+    # The buffer is only used for reads spanning multiple read_nonblock
+    # calls, whose contents are always copied out before the buffer is
+    # read into again. read_nonblock resizes the buffer as needed, thus
+    # the buffer grows only when a read requires it to.
+    def reusable_read_buffer
+      @reusable_read_buffer ||= allocate_string(read_buffer_size)
+    end
+
     # Writes data to the socket instance.
     #
     # This is a separate method from +write+ for ease of mocking in the tests.
@@ -397,15 +437,42 @@ module Mongo
       # data on the same hardware). Unfortunately splitting the data,
       # one would assume, results in it being copied, but this seems to be
       # a much more minor issue compared to CPU cost of writing large buffers.
-      args.each do |buf|
+      #
+      # Messages serialized in segments start with a small header segment.
+      # Since TCP_NODELAY is set, writing each segment separately would
+      # send small messages in several packets and system calls, thus
+      # buffers smaller than WRITE_COALESCE_SIZE are combined with the
+      # following buffers into a single write.
+      pending = nil
+      args.each_with_index do |buf, index|
         buf = buf.to_s
-        i = 0
-        while i < buf.length
-          chunk = buf[i...i+WRITE_CHUNK_SIZE]
-          @socket.write(chunk)
-          i += WRITE_CHUNK_SIZE
+        buf = buf.b unless buf.encoding == Encoding::BINARY
+        if buf.bytesize < WRITE_COALESCE_SIZE
+          if pending.nil? && index == args.length - 1
+            @socket.write(buf)
+          else
+            (pending ||= String.new(encoding: Encoding::BINARY)) << buf
+            if pending.bytesize >= WRITE_COALESCE_SIZE
+              @socket.write(pending)
+              pending = nil
+            end
+          end
+        else
+          i = 0
+          if pending
+            # Send the pending bytes with the start of this buffer.
+            i = WRITE_CHUNK_SIZE - pending.bytesize
+            pending << buf.byteslice(0, i)
+            @socket.write(pending)
+            pending = nil
+          end
+          while i < buf.bytesize
+            @socket.write(buf.byteslice(i, WRITE_CHUNK_SIZE))
+            i += WRITE_CHUNK_SIZE
+          end
         end
       end
+      @socket.write(pending) if pending
     end
 
     def unix_socket?(sock)
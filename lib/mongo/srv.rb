@@ -16,5 +16,6 @@
 # limitations under the License.
 
 require 'mongo/srv/result'
+require 'mongo/srv/cache'
 require 'mongo/srv/resolver'
 require 'mongo/srv/monitor'
@@ -0,0 +1,141 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the 'License');
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an 'AS IS' BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  module Srv
+
+    # Caches the results of SRV and TXT DNS lookups for the TTL of the
+    # returned records.
+    #
+    # The cache is shared by all clients and SRV monitors in the process,
+    # so that clients created with the same SRV URI resolve it once per TTL
+    # rather than once per client. Once most of its TTL has elapsed, a
+    # cached result is refreshed in a background thread the next time it is
+    # requested, while the cached result continues to be returned; a lookup
+    # only blocks when there is no unexpired result. Concurrent lookups with
+    # the same key that cannot be served from the cache are merged into a
+    # single DNS query.
+    #
+    # @api private
+    module Cache
+
+      # The fraction of the TTL of a cached result after which the result
+      # is refreshed in the background.
+      REFRESH_FRACTION = 0.75
+
+      # The time, in seconds, for which lookups that returned no records
+      # are cached.
+      NEGATIVE_TTL = 30
+
+      LOCK = Mutex.new
+
+      CONDITION = ConditionVariable.new
+
+      Entry = Struct.new(:resources, :refresh_at, :expires_at, :refreshing)
+
+      # Returns the cached records for the key, performing the lookup when
+      # there is no unexpired cached result.
+      #
+      # @param [ Object ] key The cache key, identifying the queried name,
+      #   record type and resolver configuration.
+      #
+      # @yieldreturn [ Array<Resolv::DNS::Resource> ] The records obtained
+      #   from DNS. The block may also be called in a background thread to
+      #   refresh the cached result.
+      #
+      # @return [ Array<Resolv::DNS::Resource> ] The records.
+      module_function def fetch(key, &block)
+        LOCK.synchronize do
+          loop do
+            now = Utils.monotonic_time
+            entry = entries[key]
+            if entry && entry.expires_at > now
+              if !entry.refreshing && entry.refresh_at <= now
+                entry.refreshing = true
+                refresh(key, block)
+              end
+              return entry.resources
+            end
+
+            entries.delete(key)
+            if pending.include?(key)
+              # Another thread is performing the same lookup.
+              CONDITION.wait(LOCK)
+              next
+            end
+
+            pending << key
+            begin
+              LOCK.unlock
+              begin
+                resources = yield
+              ensure
+                LOCK.lock
+              end
+              return store(key, resources).resources
+            ensure
+              pending.delete(key)
+              CONDITION.broadcast
+            end
+          end
+        end
+      end
+
+      # Discards all cached results.
+      module_function def clear
+        LOCK.synchronize do
+          entries.clear
+        end
+      end
+
+      private
+
+      module_function def entries
+        @entries ||= {}
+      end
+
+      module_function def pending
+        @pending ||= []
+      end
+
+      # Must be called with the lock held.
+      module_function def store(key, resources)
+        resources = resources.dup.freeze
+        ttl = resources.map(&:ttl).min || NEGATIVE_TTL
+        now = Utils.monotonic_time
+        Entry.new(resources, now + ttl * REFRESH_FRACTION, now + ttl, false).tap do |entry|
+          entries[key] = entry
+        end
+      end
+
+      module_function def refresh(key, block)
+        Thread.new do
+          begin
+            resources = block.call
+            LOCK.synchronize do
+              store(key, resources)
+            end
+          rescue StandardError
+            # The cached result remains in use until it expires, at which
+            # point the next lookup is performed in the foreground and its
+            # error is reported to the caller.
+          end
+        end
+      end
+    end
+  end
+end
@@ -25,6 +25,9 @@ module Mongo
     # or disallowed for security reasons, a warning is logged and monitoring
     # continues.
     #
+    # Lookups use the process-wide Srv::Cache, so that monitors of clients
+    # sharing an SRV URI query DNS once per TTL of the records.
+    #
     # @api private
     class Monitor
       include Loggable
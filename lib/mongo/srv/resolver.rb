@@ -21,6 +21,9 @@ module Mongo
     # Encapsulates the necessary behavior for querying SRV records as
     # required by the driver.
     #
+    # Lookup results are cached for the TTL of the records, in a cache
+    # shared by all resolvers in the process (see Srv::Cache).
+    #
     # @api private
     class Resolver
       include Loggable
@@ -68,7 +71,7 @@ module Mongo
       # @return [ Mongo::Srv::Result ] SRV lookup result.
       def get_records(hostname)
         query_name = RECORD_PREFIX + hostname
-        resources = @resolver.getresources(query_name, Resolv::DNS::Resource::IN::SRV)
+        resources = getresources(query_name, Resolv::DNS::Resource::IN::SRV)
 
         # Collect all of the records into a Result object, raising an error
         # or logging a warning if a record with a mismatched domain is found.
@@ -109,7 +112,7 @@ module Mongo
       #
       # @raise [ Mongo::Error::InvalidTXTRecord ] If more than one TXT record is found.
       def get_txt_options_string(hostname)
-        records = @resolver.getresources(hostname, Resolv::DNS::Resource::IN::TXT)
+        records = getresources(hostname, Resolv::DNS::Resource::IN::TXT)
         if records.empty?
           return nil
         end
@@ -125,6 +128,19 @@ module Mongo
 
       private
 
+      # Looks up the records of a name, using the process-wide cache of
+      # DNS lookup results.
+      #
+      # @param [ String ] name The name to query.
+      # @param [ Class ] type The resource type to query.
+      #
+      # @return [ Array<Resolv::DNS::Resource> ] The records.
+      def getresources(name, type)
+        Cache.fetch([ name, type, options[:resolv_options] ]) do
+          @resolver.getresources(name, type)
+        end
+      end
+
       # Checks whether an error should be raised due to either a record with
       # a mismatched domain being found or no records being found.
       #
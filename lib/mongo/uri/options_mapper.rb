@@ -234,6 +234,7 @@ module Mongo
       uri_option 'localThresholdMS', :local_threshold, type: :ms
       uri_option 'heartbeatFrequencyMS', :heartbeat_frequency, type: :ms
       uri_option 'maxIdleTimeMS', :max_idle_time, type: :ms
+      uri_option 'timeoutMS', :timeout_ms, type: :integer
 
       # Write Options
       uri_option 'w', :w, group: :write_concern, type: :w
@@ -249,6 +250,7 @@ module Mongo
       # Pool options
       uri_option 'minPoolSize', :min_pool_size, type: :integer
       uri_option 'maxPoolSize', :max_pool_size, type: :integer
+      uri_option 'maxConnecting', :max_connecting, type: :integer
       uri_option 'waitQueueTimeoutMS', :wait_queue_timeout, type: :ms
 
       # Security Options
@@ -102,6 +102,16 @@ module Mongo
       Process.clock_gettime(Process::CLOCK_MONOTONIC)
     end
 
+    # Returns the fiber scheduler of the current thread, if the Ruby
+    # implementation supports fiber schedulers and one is set.
+    #
+    # @return [ Object | nil ] The fiber scheduler.
+    module_function def fiber_scheduler
+      if Fiber.respond_to?(:scheduler)
+        Fiber.scheduler
+      end
+    end
+
     # Hash#compact implementation for Ruby 2.3/2.4
     # Implementation based on activesupport 5.2.3
     module_function def slice_hash(hash, *keys)
@@ -16,11 +16,14 @@
 # limitations under the License.
 
 require 'benchmark'
+require 'json'
+require 'time'
 require_relative 'benchmarking/helper'
 require_relative 'benchmarking/micro'
 require_relative 'benchmarking/single_doc'
 require_relative 'benchmarking/multi_doc'
 require_relative 'benchmarking/parallel'
+require_relative 'benchmarking/driver'
 
 module Mongo
 
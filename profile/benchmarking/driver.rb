@@ -0,0 +1,279 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+# Copyright (C) 2021 MongoDB Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+module Mongo
+  module Benchmarking
+
+    # Driver benchmarks exercise the parts of the driver whose performance
+    # matters most to applications: connection pool contention, cursor
+    # iteration, wire compression, GridFS and bulk writes.
+    #
+    # Unlike the other benchmarks, they generate their own data, and report
+    # latency percentiles, allocations per operation and garbage collection
+    # time in addition to throughput, so that results of different releases
+    # can be compared. The server to run against is taken from the
+    # MONGODB_URI environment variable and defaults to localhost:27017.
+    #
+    # @example Run all driver benchmarks and save the results.
+    #   Benchmarking::Driver.run_all('benchmark-results.json')
+    module Driver
+
+      extend self
+
+      # The benchmarks run by #run_all.
+      BENCHMARKS = %i(
+        pool_contention
+        cursor_iteration
+        cursor_get_more
+        compression
+        gridfs
+        bulk_write
+      ).freeze
+
+      # Run a driver benchmark and print its results.
+      #
+      # @example Run a benchmark.
+      #   Benchmarking::Driver.run(:pool_contention)
+      #
+      # @param [ Symbol ] type The benchmark to run.
+      # @param [ Integer ] repetitions The number of measured repetitions.
+      #
+      # @return [ Array<Hash> ] The results.
+      def run(type, repetitions = Benchmarking::TEST_REPETITIONS)
+        Mongo::Logger.logger.level = ::Logger::WARN
+        Array(send(type, repetitions)).each do |results|
+          latency = results['latency']
+          puts format('%-40s p50 %.6fs  p99 %.6fs  %.1f ops/s  %.1f allocs/op  gc %.3fs',
+            results['name'], latency['p50'], latency['p99'],
+            results['ops_per_second'], results['allocations_per_op'],
+            results['gc_time'])
+        end
+      end
+
+      # Run all driver benchmarks and write their results to a JSON file.
+      #
+      # @example Run all benchmarks.
+      #   Benchmarking::Driver.run_all('benchmark-results.json')
+      #
+      # @param [ String ] path The path of the file to write.
+      # @param [ Integer ] repetitions The number of measured repetitions.
+      #
+      # @return [ Array<Hash> ] The results.
+      def run_all(path, repetitions = Benchmarking::TEST_REPETITIONS)
+        results = BENCHMARKS.map { |type| run(type, repetitions) }.flatten
+        Benchmarking.write_results(results, path)
+        results
+      end
+
+      # Test many threads sharing a small connection pool.
+      #
+      # @example Test pool contention.
+      #   Benchmarking::Driver.pool_contention(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Hash ] The results.
+      def pool_contention(repetitions)
+        threads = 20
+        ops_per_thread = 10
+        contended = new_client(max_pool_size: 5)
+        contended.database.command(ping: 1)
+
+        Benchmarking.measure('pool_contention', repetitions, warmup: 2) do
+          Array.new(threads) do
+            Thread.new do
+              Array.new(ops_per_thread) do
+                Benchmark.realtime do
+                  contended.database.command(ping: 1)
+                end
+              end
+            end
+          end.map(&:value).flatten
+        end
+      ensure
+        contended&.close
+      end
+
+      # Test iterating a cursor returning documents in large batches.
+      #
+      # @example Test cursor iteration.
+      #   Benchmarking::Driver.cursor_iteration(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Hash ] The results.
+      def cursor_iteration(repetitions)
+        iterate(:cursor_iteration, repetitions, {})
+      end
+
+      # Test iterating a cursor requiring many getMore commands.
+      #
+      # @example Test getMore.
+      #   Benchmarking::Driver.cursor_get_more(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Hash ] The results.
+      def cursor_get_more(repetitions)
+        iterate(:cursor_get_more, repetitions, batch_size: 100)
+      end
+
+      # Test reading documents with each available wire compressor, and
+      # without compression.
+      #
+      # @example Test compression.
+      #   Benchmarking::Driver.compression(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Array<Hash> ] The results for each compressor.
+      def compression(repetitions)
+        prepare_documents(1_000)
+
+        ([ nil ] + available_compressors).map do |compressor|
+          compressed = new_client(compressor ? { compressors: [ compressor ] } : {})
+          coll = compressed[:corpus]
+          begin
+            Benchmarking.measure("find_many_#{compressor || 'uncompressed'}", repetitions) do
+              coll.find.to_a
+            end
+          ensure
+            compressed.close
+          end
+        end
+      ensure
+        client.database.drop
+      end
+
+      # Test uploading and downloading a GridFS file.
+      #
+      # @example Test GridFS.
+      #   Benchmarking::Driver.gridfs(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Array<Hash> ] The upload and download results.
+      def gridfs(repetitions)
+        client.database.drop
+        fs = client.database.fs
+        data = Random.new(42).bytes(16 * 1024 * 1024)
+        file_id = fs.upload_from_stream('gridfs_download', StringIO.new(data))
+        io = StringIO.new
+
+        [
+          Benchmarking.measure('gridfs_upload', repetitions, warmup: 1, bytes: data.bytesize) do
+            fs.upload_from_stream('gridfs_upload', StringIO.new(data))
+          end,
+          Benchmarking.measure('gridfs_download', repetitions, warmup: 1, bytes: data.bytesize) do
+            io.truncate(0)
+            io.rewind
+            fs.download_to_stream(file_id, io)
+          end,
+        ]
+      ensure
+        client.database.drop
+      end
+
+      # Test ordered and unordered bulk writes mixing inserts, updates and
+      # deletes.
+      #
+      # @example Test bulk writes.
+      #   Benchmarking::Driver.bulk_write(10)
+      #
+      # @param [ Integer ] repetitions The number of test repetitions.
+      #
+      # @return [ Array<Hash> ] The ordered and unordered results.
+      def bulk_write(repetitions)
+        client.database.drop
+        coll = client[:corpus]
+
+        [ true, false ].map do |ordered|
+          name = ordered ? 'bulk_write_ordered' : 'bulk_write_unordered'
+          Benchmarking.measure(name, repetitions, warmup: 2, ops: 1_000) do
+            requests = Array.new(500) do |i|
+              { insert_one: document(i) }
+            end
+            requests += Array.new(250) do |i|
+              { update_one: { filter: { index: i }, update: { '$inc' => { count: 1 } } } }
+            end
+            requests += Array.new(250) do |i|
+              { delete_one: { filter: { index: i + 250 } } }
+            end
+            coll.bulk_write(requests, ordered: ordered)
+          end
+        end
+      ensure
+        client.database.drop
+      end
+
+      private
+
+      def iterate(name, repetitions, options)
+        prepare_documents(10_000)
+        Benchmarking.measure(name, repetitions, ops: 10_000) do
+          client[:corpus].find({}, options).each {}
+        end
+      ensure
+        client.database.drop
+      end
+
+      def prepare_documents(count)
+        client.database.drop
+        client[:corpus].insert_many(Array.new(count) { |i| document(i) })
+      end
+
+      # A document of roughly 1KB with a mix of field types.
+      def document(index)
+        {
+          index: index,
+          name: "user#{index}",
+          email: "user#{index}@example.com",
+          created_at: Time.at(1_600_000_000 + index),
+          score: index * 1.5,
+          tags: %w(alpha beta gamma delta).rotate(index % 4),
+          address: { street: "#{index} Main Street", city: 'Springfield', zip: format('%05d', index % 100_000) },
+          history: Array.new(10) { |i| { at: Time.at(1_600_000_000 + i), event: "event#{i}", value: i * index } },
+          bio: 'Lorem ipsum dolor sit amet, consectetur adipiscing elit. ' * 8,
+        }
+      end
+
+      def available_compressors
+        compressors = %w(zlib)
+        begin
+          require 'snappy'
+          compressors << 'snappy'
+        rescue LoadError
+        end
+        begin
+          require 'zstd-ruby'
+          compressors << 'zstd'
+        rescue LoadError
+        end
+        compressors
+      end
+
+      def client
+        @client ||= new_client
+      end
+
+      def new_client(options = {})
+        Mongo::Client.new(ENV.fetch('MONGODB_URI', 'mongodb://localhost:27017'),
+          { database: 'perftest', monitoring: false }.merge(options))
+      end
+    end
+  end
+end
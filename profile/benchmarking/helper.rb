@@ -58,5 +58,118 @@ module Mongo
     def median(values)
       values.sort![values.size/2-1]
     end
+
+    # Get the value at the given percentile of a list, using the
+    # nearest-rank method.
+    #
+    # @example Get the 99th percentile.
+    #   Benchmarking.percentile(values, 99)
+    #
+    # @param [ Array<Numeric> ] values The values.
+    # @param [ Numeric ] percentile The percentile, between 0 and 100.
+    #
+    # @return [ Numeric ] The value at the percentile.
+    def percentile(values, percentile)
+      sorted = values.sort
+      rank = (percentile / 100.0 * sorted.length).ceil
+      sorted[[rank - 1, 0].max]
+    end
+
+    # Get the total time spent in garbage collection by this process.
+    #
+    # @return [ Float ] The garbage collection time in seconds.
+    def gc_time
+      if GC.stat.key?(:time)
+        GC.stat(:time) / 1000.0
+      else
+        GC::Profiler.total_time
+      end
+    end
+
+    # Measure a block, recording the latency of each repetition, the
+    # objects allocated and the time spent in garbage collection.
+    #
+    # A block performing several operations per repetition, for example in
+    # several threads, may report the latency of each operation by
+    # returning an array of latencies in seconds. Otherwise the
+    # wall time of each repetition is recorded as a single latency.
+    #
+    # @example Measure inserts.
+    #   Benchmarking.measure('insert_one', 1000) { collection.insert_one(doc) }
+    #
+    # @param [ String ] name The name of the benchmark.
+    # @param [ Integer ] repetitions The number of measured repetitions.
+    # @param [ Hash ] options The options.
+    #
+    # @option options [ Integer ] :warmup The number of repetitions to run
+    #   before measuring.
+    # @option options [ Integer ] :ops The number of operations performed
+    #   by each repetition, used to compute allocations per operation when
+    #   the block does not return latencies.
+    # @option options [ Integer ] :bytes The number of bytes transferred by
+    #   each repetition, used to compute the throughput.
+    #
+    # @return [ Hash ] The results, suitable for serializing as JSON.
+    def measure(name, repetitions, options = {})
+      (options[:warmup] || WARMUP_REPETITIONS).times { yield }
+
+      GC.start
+      GC::Profiler.enable unless GC.stat.key?(:time)
+      gc_before = gc_time
+      allocated_before = GC.stat(:total_allocated_objects)
+      latencies = []
+      wall = Benchmark.realtime do
+        repetitions.times do
+          result = nil
+          elapsed = Benchmark.realtime { result = yield }
+          if result.is_a?(Array) && !result.empty? && result.all? { |value| value.is_a?(Float) }
+            latencies.concat(result)
+          else
+            latencies << elapsed
+          end
+        end
+      end
+      allocated = GC.stat(:total_allocated_objects) - allocated_before
+      gc = gc_time - gc_before
+      GC::Profiler.disable unless GC.stat.key?(:time)
+
+      ops = [latencies.length, repetitions * (options[:ops] || 1)].max
+      {
+        'name' => name.to_s,
+        'repetitions' => repetitions,
+        'operations' => ops,
+        'wall_time' => wall,
+        'ops_per_second' => ops / wall,
+        'latency' => {
+          'mean' => latencies.sum / latencies.length,
+          'p50' => percentile(latencies, 50),
+          'p99' => percentile(latencies, 99),
+          'max' => latencies.max,
+        },
+        'allocations_per_op' => allocated.to_f / ops,
+        'gc_time' => gc,
+      }.tap do |results|
+        if options[:bytes]
+          results['bytes_per_second'] = options[:bytes] * repetitions / wall
+        end
+      end
+    end
+
+    # Write benchmark results to a file as JSON, together with information
+    # about the environment they were obtained in.
+    #
+    # @param [ Array<Hash> ] results The results returned by #measure.
+    # @param [ String ] path The path of the file to write.
+    def write_results(results, path)
+      report = {
+        'driver_version' => Mongo::VERSION,
+        'bson_version' => BSON::VERSION,
+        'ruby_engine' => RUBY_ENGINE,
+        'ruby_version' => RUBY_VERSION,
+        'timestamp' => Time.now.utc.iso8601,
+        'benchmarks' => results,
+      }
+      File.write(path, JSON.pretty_generate(report) + "\n")
+    end
   end
 end
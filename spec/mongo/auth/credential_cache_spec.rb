@@ -0,0 +1,93 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::Auth::CredentialCache do
+  before do
+    described_class.clear
+  end
+
+  after do
+    described_class.clear
+  end
+
+  describe '.cache' do
+    it 'computes the value once' do
+      calls = 0
+      2.times do
+        described_class.cache([:key]) do
+          calls += 1
+          'value'
+        end.should == 'value'
+      end
+      calls.should == 1
+    end
+
+    context 'when the value is requested concurrently' do
+      it 'computes the value once' do
+        calls = 0
+        threads = Array.new(5) do
+          Thread.new do
+            described_class.cache([:key]) do
+              calls += 1
+              sleep 0.1
+              'value'
+            end
+          end
+        end
+        threads.map(&:value).should == ['value'] * 5
+        calls.should == 1
+      end
+    end
+
+    context 'when computing the value fails' do
+      it 'does not cache anything' do
+        expect do
+          described_class.cache([:key]) do
+            raise 'failed'
+          end
+        end.to raise_error(RuntimeError, 'failed')
+
+        described_class.get([:key]).should be nil
+        described_class.cache([:key]) { 'value' }.should == 'value'
+      end
+    end
+
+    context 'when computing the value fails while other threads wait' do
+      it 'does not compute the value concurrently' do
+        lock = Mutex.new
+        running = 0
+        max_running = 0
+        attempts = 0
+        compute = lambda do
+          begin
+            described_class.cache([:key]) do
+              lock.synchronize do
+                attempts += 1
+                running += 1
+                max_running = [ max_running, running ].max
+              end
+              sleep 0.05
+              lock.synchronize { running -= 1 }
+              raise 'failed' if attempts == 1
+              'value'
+            end
+          rescue RuntimeError
+            nil
+          end
+        end
+
+        waiting = Array.new(3) { Thread.new(&compute) }
+        sleep 0.07
+        # Arrives after the first computation failed, while the other
+        # threads are still waiting for the lock.
+        late = Array.new(2) { Thread.new(&compute) }
+
+        (waiting + late).each(&:join)
+        max_running.should == 1
+        described_class.get([:key]).should == 'value'
+      end
+    end
+  end
+end
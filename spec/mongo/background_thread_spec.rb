@@ -0,0 +1,92 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+require 'support/fiber_scheduler'
+
+describe Mongo::BackgroundThread do
+
+  let(:worker_class) do
+    Class.new do
+      include Mongo::BackgroundThread
+
+      def initialize(options)
+        @options = options
+        @iterations = 0
+        @semaphore = Mongo::Semaphore.new
+      end
+
+      attr_reader :options, :iterations
+
+      private
+
+      def do_work
+        @iterations += 1
+        @semaphore.wait(0.05)
+      end
+
+      def pre_stop
+        @semaphore.signal
+      end
+    end
+  end
+
+  let(:worker) do
+    worker_class.new(options)
+  end
+
+  let(:options) do
+    { background_fibers: true }
+  end
+
+  context 'when there is no fiber scheduler' do
+
+    after do
+      worker.stop!
+    end
+
+    it 'runs in a thread' do
+      expect(worker.run!).to be_a(Thread)
+    end
+  end
+
+  context 'when there is a fiber scheduler' do
+    require_mri
+
+    before do
+      unless Fiber.respond_to?(:set_scheduler)
+        skip 'Fiber schedulers are not supported'
+      end
+    end
+
+    it 'runs as a fiber on the scheduler' do
+      task = nil
+      stopped = nil
+      TestFiberScheduler.run do
+        task = worker.run!
+        sleep 0.2
+        stopped = worker.stop!
+      end
+      expect(task).to be_a(described_class::FiberTask)
+      expect(worker.iterations).to be > 1
+      expect(stopped).to be true
+      expect(worker).not_to be_running
+    end
+
+    context 'when background fibers are not requested' do
+
+      let(:options) do
+        {}
+      end
+
+      it 'runs in a thread' do
+        task = nil
+        TestFiberScheduler.run do
+          task = worker.run!
+          worker.stop!
+        end
+        expect(task).to be_a(Thread)
+      end
+    end
+  end
+end
@@ -2233,6 +2233,84 @@ describe Mongo::BulkWrite do
 
       it_behaves_like 'an executable bulk write'
     end
+
+    context 'when the bulk write is unordered and concurrent' do
+
+      let(:subscriber) { Mrss::EventSubscriber.new }
+
+      let(:client) do
+        authorized_client.tap do |client|
+          client.subscribe(Mongo::Monitoring::COMMAND, subscriber)
+        end
+      end
+
+      let(:collection) do
+        client[authorized_collection.name]
+      end
+
+      let(:requests) do
+        250.times.map do |i|
+          { insert_one: { _id: i } }
+        end
+      end
+
+      let(:bulk_write) do
+        described_class.new(collection, requests, ordered: false, concurrency: 3)
+      end
+
+      let(:insert_events) do
+        subscriber.started_events.select { |event| event.command_name == 'insert' }
+      end
+
+      before do
+        allow_any_instance_of(Mongo::Server::Description).to receive(:max_write_batch_size).and_return(100)
+      end
+
+      it 'sends the batches separately' do
+        expect(bulk_write.execute.inserted_count).to eq(250)
+        expect(insert_events.map { |event| event.command['documents'].length }.sort).to eq([50, 100, 100])
+        expect(collection.count_documents).to eq(250)
+      end
+
+      it 'uses a session per concurrent batch' do
+        bulk_write.execute
+        expect(insert_events.map { |event| event.command['lsid'] }.uniq.length).to be > 1
+      end
+
+      it 'returns the inserted ids in request order' do
+        expect(bulk_write.execute.inserted_ids).to eq((0...250).to_a)
+      end
+
+      context 'when a write error occurs' do
+        let(:requests) do
+          250.times.map do |i|
+            { insert_one: { _id: i == 200 ? 5 : i } }
+          end
+        end
+
+        it 'reports the index of the failed request' do
+          expect do
+            bulk_write.execute
+          end.to raise_error(Mongo::Error::BulkWriteError) { |error|
+            expect(error.result['writeErrors'].map { |e| e['index'] }).to eq([200])
+            expect(error.result['n_inserted']).to eq(249)
+          }
+        end
+      end
+
+      context 'when an explicit session is provided' do
+        let(:session) { client.start_session }
+
+        let(:bulk_write) do
+          described_class.new(collection, requests, ordered: false, concurrency: 3, session: session)
+        end
+
+        it 'sends the batches sequentially using the session' do
+          bulk_write.execute
+          expect(insert_events.map { |event| event.command['lsid'] }.uniq).to eq([session.session_id])
+        end
+      end
+    end
   end
 
   describe '#initialize' do
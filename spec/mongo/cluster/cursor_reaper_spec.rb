@@ -166,6 +166,103 @@ describe Mongo::Cluster::CursorReaper do
     end
   end
 
+  describe '#kill_cursors' do
+
+    let(:address) { Mongo::Address.new('localhost') }
+
+    let(:server) do
+      double('server').tap do |server|
+        allow(server).to receive(:address).and_return(address)
+        allow(server).to receive(:options).and_return({})
+      end
+    end
+
+    let(:cluster) do
+      double('cluster').tap do |cluster|
+        allow(cluster).to receive(:servers).and_return([server])
+      end
+    end
+
+    let(:operation) do
+      double('operation').tap do |operation|
+        allow(operation).to receive(:execute)
+      end
+    end
+
+    def schedule(cursor_id, coll_name)
+      reaper.register_cursor(cursor_id)
+      reaper.schedule_kill_cursor(
+        Mongo::Cursor::KillSpec.new(
+          cursor_id: cursor_id, coll_name: coll_name, db_name: 'd', service_id: nil,
+        ),
+        server,
+      )
+    end
+
+    context 'when several cursors are scheduled for the same namespace' do
+
+      before do
+        (1..3).each { |id| schedule(id, 'c') }
+        schedule(4, 'e')
+      end
+
+      it 'kills them with one command per namespace' do
+        expect(Mongo::Operation::KillCursors).to receive(:new).with(
+          hash_including(cursor_ids: contain_exactly(1, 2, 3), coll_name: 'c')
+        ).and_return(operation)
+        expect(Mongo::Operation::KillCursors).to receive(:new).with(
+          hash_including(cursor_ids: [4], coll_name: 'e')
+        ).and_return(operation)
+        expect(reaper.kill_cursors).to eq(2)
+      end
+
+      it 'updates the statistics' do
+        allow(Mongo::Operation::KillCursors).to receive(:new).and_return(operation)
+        expect(reaper.stats[:backlog]).to eq(4)
+        reaper.kill_cursors
+        stats = reaper.stats
+        expect(stats[:backlog]).to eq(0)
+        expect(stats[:cursors_killed]).to eq(4)
+        expect(stats[:commands_sent]).to eq(2)
+        expect(stats[:last_latency]).to be >= 0
+      end
+    end
+
+    context 'when a scheduled cursor is no longer active' do
+
+      before do
+        schedule(1, 'c')
+        reaper.unregister_cursor(1)
+      end
+
+      it 'does not send a command' do
+        expect(Mongo::Operation::KillCursors).not_to receive(:new)
+        expect(reaper.kill_cursors).to eq(0)
+      end
+    end
+
+    context 'when more commands are needed than are sent per execution' do
+
+      before do
+        stub_const("#{described_class}::MAX_CURSOR_IDS_PER_COMMAND", 2)
+        stub_const("#{described_class}::MAX_COMMANDS_PER_EXECUTION", 2)
+        (1..5).each { |id| schedule(id, 'c') }
+        allow(Mongo::Operation::KillCursors).to receive(:new).and_return(operation)
+      end
+
+      it 'leaves the remaining cursors scheduled' do
+        expect(reaper.kill_cursors).to eq(2)
+        expect(reaper.stats[:backlog]).to eq(1)
+      end
+
+      it 'kills all cursors when flushed' do
+        reaper.flush
+        expect(reaper.stats[:backlog]).to eq(0)
+        expect(reaper.stats[:cursors_killed]).to eq(5)
+      end
+    end
+  end
+
   context 'when a non-exhausted cursor goes out of scope' do
 
     let(:docs) do
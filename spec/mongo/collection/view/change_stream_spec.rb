@@ -426,6 +426,133 @@ describe Mongo::Collection::View::ChangeStream do
     end
   end
 
+  describe '#try_next_batch' do
+
+    context 'when changes are available' do
+
+      before do
+        change_stream
+        collection.insert_many([ { a: 1 }, { a: 2 }, { a: 3 } ])
+      end
+
+      let(:documents) do
+        documents = []
+        5.times do
+          documents.concat(change_stream.try_next_batch)
+          break if documents.length == 3
+        end
+        documents
+      end
+
+      it 'returns the changes' do
+        expect(documents.map { |doc| doc['fullDocument']['a'] }).to eq([ 1, 2, 3 ])
+      end
+
+      it 'advances the resume token past the batch' do
+        expect(change_stream.resume_token).not_to be_nil
+        expect(change_stream.resume_token).not_to eq(documents.first['_id'])
+      end
+    end
+
+    context 'when a document of the batch was returned by try_next' do
+
+      before do
+        change_stream
+        collection.insert_many([ { a: 1 }, { a: 2 } ])
+      end
+
+      it 'returns the remaining documents' do
+        first = nil
+        5.times do
+          break if first = change_stream.try_next
+        end
+        documents = change_stream.try_next_batch
+        documents = change_stream.try_next_batch if documents.empty?
+        expect(first['fullDocument']['a']).to eq(1)
+        expect(documents.map { |doc| doc['fullDocument']['a'] }).to eq([ 2 ])
+      end
+    end
+
+    context 'when the stream is closed' do
+
+      before do
+        change_stream.close
+      end
+
+      it 'raises StopIteration' do
+        expect do
+          change_stream.try_next_batch
+        end.to raise_error(StopIteration)
+      end
+    end
+  end
+
+  describe '#each_batch' do
+
+    let(:options) do
+      { max_await_time_ms: 100 }
+    end
+
+    before do
+      change_stream
+      collection.insert_many([ { a: 1 }, { a: 2 } ])
+    end
+
+    it 'yields the batches with their resume tokens' do
+      documents = []
+      tokens = []
+      change_stream.each_batch do |batch, resume_token|
+        expect(batch).not_to be_empty
+        documents.concat(batch)
+        tokens << resume_token
+        change_stream.close if documents.length == 2
+      end
+      expect(documents.map { |doc| doc['fullDocument']['a'] }).to eq([ 1, 2 ])
+      expect(tokens).to all(be_a(BSON::Document))
+    end
+  end
+
+  context 'when prefetching' do
+    let(:subscriber) { Mrss::EventSubscriber.new }
+
+    let(:client) do
+      authorized_client_without_any_retry_reads.tap do |client|
+        client.subscribe(Mongo::Monitoring::COMMAND, subscriber)
+      end
+    end
+
+    let(:view_options) do
+      { prefetch: true }
+    end
+
+    let(:options) do
+      { max_await_time_ms: 100 }
+    end
+
+    let(:get_more_events) do
+      subscriber.started_events.select { |event| event.command_name == 'getMore' }
+    end
+
+    it 'returns the changes in order' do
+      change_stream
+      collection.insert_many([ { a: 1 }, { a: 2 }, { a: 3 } ])
+      documents = []
+      10.times do
+        documents.concat(change_stream.try_next_batch)
+        break if documents.length == 3
+      end
+      expect(documents.map { |doc| doc['fullDocument']['a'] }).to eq([ 1, 2, 3 ])
+    end
+
+    it 'sends the next getMore before the current batch is processed' do
+      change_stream.try_next_batch
+      thread = cursor.instance_variable_get(:@prefetch_thread)
+      expect(thread).not_to be_nil
+      thread.join
+      expect(get_more_events.length).to eq(2)
+    end
+  end
+
   describe '#closed?' do
 
     context 'when the change stream has not been closed' do
@@ -37,5 +37,21 @@ describe Mongo::Collection::View::Iterable do
         end
       end
     end
+
+    context 'when raw is provided' do
+      min_server_fcv '3.6'
+
+      let(:options) { { raw: true, batch_size: 2 } }
+
+      before do
+        authorized_collection.insert_many([ { a: 1 }, { a: 2 }, { a: 3 } ])
+      end
+
+      it 'returns raw documents from all batches' do
+        documents = view.to_a
+        expect(documents).to all be_a(Mongo::RawDocument)
+        expect(documents.map { |doc| doc['a'] }).to eq([1, 2, 3])
+      end
+    end
   end
 end
@@ -1072,6 +1072,64 @@ describe Mongo::Collection::View::Readable do
     end
   end
 
+  describe '#export_to' do
+
+    let(:documents) do
+      (1..5).map { |i| { '_id' => i, 'name' => "name #{i}" } }
+    end
+
+    let(:options) do
+      { batch_size: 2, sort: { _id: 1 } }
+    end
+
+    let(:io) do
+      StringIO.new(String.new)
+    end
+
+    before do
+      authorized_collection.insert_many(documents)
+    end
+
+    context 'when the format is bson' do
+
+      it 'writes the documents as BSON' do
+        expect(view.export_to(io)).to eq(5)
+        buffer = BSON::ByteBuffer.new(io.string)
+        exported = 5.times.map { BSON::Document.from_bson(buffer) }
+        expect(exported).to eq(documents)
+        expect(buffer.length).to eq(0)
+      end
+    end
+
+    context 'when the format is extended_json' do
+
+      it 'writes one document per line' do
+        expect(view.export_to(io, format: :extended_json)).to eq(5)
+        expect(io.string.lines.map { |line| JSON.parse(line) }).to eq(documents)
+      end
+    end
+
+    context 'when prefetching' do
+
+      let(:options) do
+        { batch_size: 2, sort: { _id: 1 }, prefetch: true }
+      end
+
+      it 'writes all documents' do
+        expect(view.export_to(io)).to eq(5)
+      end
+    end
+
+    context 'when the format is not supported' do
+
+      it 'raises ArgumentError' do
+        expect do
+          view.export_to(io, format: :csv)
+        end.to raise_error(ArgumentError, /Invalid export format/)
+      end
+    end
+  end
+
   describe '#hint' do
 
     context 'when a hint is specified' do
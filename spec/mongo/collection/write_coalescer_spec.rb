@@ -0,0 +1,143 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'spec_helper'
+
+describe Mongo::Collection::WriteCoalescer do
+
+  let(:subscriber) { EventSubscriber.new }
+
+  let(:client) do
+    authorized_client.tap do |client|
+      client.subscribe(Mongo::Monitoring::COMMAND, subscriber)
+    end
+  end
+
+  let(:collection) do
+    client['write_coalescer_spec', coalesce_writes: { window: 0.05 }]
+  end
+
+  before do
+    authorized_client['write_coalescer_spec'].drop
+  end
+
+  describe '#initialize' do
+
+    it 'uses the defaults when given true' do
+      coalescer = described_class.new(collection, true)
+      expect(coalescer.window).to eq(described_class::DEFAULT_WINDOW)
+      expect(coalescer.max_batch_size).to eq(described_class::DEFAULT_MAX_BATCH_SIZE)
+    end
+
+    it 'rejects a negative window' do
+      expect do
+        described_class.new(collection, window: -1)
+      end.to raise_error(ArgumentError, /window/)
+    end
+
+    it 'rejects a non-positive max batch size' do
+      expect do
+        described_class.new(collection, max_batch_size: 0)
+      end.to raise_error(ArgumentError, /batch size/)
+    end
+  end
+
+  describe 'Collection#insert_one' do
+
+    let(:results) do
+      Array.new(10) do |i|
+        Thread.new do
+          collection.insert_one(i: i)
+        end
+      end.map(&:value)
+    end
+
+    it 'combines concurrent inserts into fewer commands' do
+      expect(results.length).to eq(10)
+      expect(subscriber.command_started_events('insert').length).to be < 10
+      expect(collection.count_documents).to eq(10)
+    end
+
+    it 'returns the id of each document to its caller' do
+      ids = results.map(&:inserted_id)
+      expect(ids.uniq.length).to eq(10)
+      results.each do |result|
+        expect(result).to be_acknowledged
+        expect(result.n).to eq(1)
+        doc = collection.find(_id: result.inserted_id).first
+        expect(doc).not_to be_nil
+      end
+    end
+
+    it 'preserves the id given by the application' do
+      expect(collection.insert_one(_id: 'given').inserted_id).to eq('given')
+    end
+
+    it 'does not coalesce inserts given options' do
+      result = collection.insert_one({ i: 1 }, bypass_document_validation: true)
+      expect(result).to be_a(Mongo::Operation::Insert::Result)
+    end
+
+    context 'when one of the documents fails to be inserted' do
+
+      before do
+        collection.insert_one(_id: 1)
+        subscriber.clear_events!
+      end
+
+      it 'raises only to the caller whose document failed' do
+        threads = [1, 2, 3].map do |id|
+          Thread.new do
+            begin
+              collection.insert_one(_id: id)
+            rescue Mongo::Error::OperationFailure => e
+              e
+            end
+          end
+        end
+        values = threads.map(&:value)
+
+        expect(values.first).to be_a(Mongo::Error::OperationFailure)
+        expect(values.first.code).to eq(11000)
+        expect(values[1].inserted_id).to eq(2)
+        expect(values[2].inserted_id).to eq(3)
+      end
+    end
+
+    context 'when more documents are inserted than fit in a batch' do
+      let(:collection) do
+        client['write_coalescer_spec', coalesce_writes: { window: 0.05, max_batch_size: 2 }]
+      end
+
+      it 'returns to each caller once its own document is inserted' do
+        expect(results.length).to eq(10)
+        expect(subscriber.command_started_events('insert').length).to be >= 5
+        expect(collection.count_documents).to eq(10)
+      end
+    end
+
+    context 'when the leader is interrupted' do
+      let(:coalescer) { described_class.new(collection, window: 0.05) }
+
+      it 'does not block the other callers' do
+        leader = Thread.new do
+          coalescer.insert_one(i: 0)
+        end
+        sleep 0.01
+        follower = Thread.new do
+          begin
+            coalescer.insert_one(i: 1)
+          rescue Mongo::Error => e
+            e
+          end
+        end
+        sleep 0.01
+        leader.kill
+        leader.join
+
+        expect(follower.join(5)).not_to be_nil
+        expect(coalescer.insert_one(i: 2).inserted_id).not_to be_nil
+      end
+    end
+  end
+end
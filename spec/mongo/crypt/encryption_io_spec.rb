@@ -5,11 +5,14 @@ require 'mongo'
 require 'spec_helper'
 
 describe Mongo::Crypt::EncryptionIO do
+  let(:reuse_kms_connections) { false }
+
   let(:subject) do
     described_class.new(
       key_vault_namespace: 'foo.bar',
       key_vault_client: authorized_client,
       mongocryptd_options: mongocryptd_options,
+      reuse_kms_connections: reuse_kms_connections,
     )
   end
 
@@ -136,4 +139,83 @@ describe Mongo::Crypt::EncryptionIO do
       end
     end
   end
+
+  describe '#feed_kms' do
+    let(:mongocryptd_options) { {} }
+
+    let(:reuse_kms_connections) { true }
+
+    let(:kms_context) do
+      double('kms context', endpoint: 'kms.example.com:443', message: 'request')
+    end
+
+    let(:socket) do
+      double('ssl socket').tap do |socket|
+        allow(socket).to receive(:syswrite)
+        allow(socket).to receive(:sysread).and_return('response')
+        allow(socket).to receive(:sysclose)
+      end
+    end
+
+    before do
+      allow(kms_context).to receive(:feed)
+    end
+
+    def feed
+      allow(kms_context).to receive(:bytes_needed).and_return(8, 0)
+      subject.feed_kms(kms_context)
+    end
+
+    it 'reuses the connection for subsequent requests' do
+      expect(subject).to receive(:connect_kms_socket).once.and_return(socket)
+      feed
+      feed
+    end
+
+    context 'when a reused connection was closed by the KMS' do
+      let(:stale_socket) do
+        double('stale ssl socket').tap do |socket|
+          writes = 0
+          allow(socket).to receive(:syswrite) do
+            writes += 1
+            raise EOFError if writes > 1
+          end
+          allow(socket).to receive(:sysread).and_return('response')
+          allow(socket).to receive(:sysclose)
+        end
+      end
+
+      it 'retries on a new connection' do
+        expect(subject).to receive(:connect_kms_socket).twice.and_return(stale_socket, socket)
+        feed
+        expect(stale_socket).to receive(:sysclose)
+        feed
+        expect(kms_context).to have_received(:feed).twice
+      end
+    end
+
+    context 'when KMS connections are not reused' do
+      let(:reuse_kms_connections) { false }
+
+      it 'closes the connection after each request' do
+        expect(subject).to receive(:connect_kms_socket).twice.and_return(socket)
+        feed
+        feed
+        expect(socket).to have_received(:sysclose).twice
+      end
+    end
+
+    context 'when a new connection fails' do
+      before do
+        allow(socket).to receive(:syswrite).and_raise(EOFError)
+      end
+
+      it 'raises KmsError' do
+        expect(subject).to receive(:connect_kms_socket).once.and_return(socket)
+        lambda do
+          feed
+        end.should raise_error(Mongo::Error::KmsError, /EOFError/)
+      end
+    end
+  end
 end
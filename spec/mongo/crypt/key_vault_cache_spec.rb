@@ -0,0 +1,104 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::Crypt::KeyVaultCache do
+  let(:cache) { described_class.new(ttl) }
+
+  let(:ttl) { 60 }
+
+  let(:id1) { BSON::Binary.new('1' * 16, :uuid) }
+  let(:id2) { BSON::Binary.new('2' * 16, :uuid) }
+
+  let(:key1) { BSON::Document.new('_id' => id1, 'keyAltNames' => ['first']) }
+  let(:key2) { BSON::Document.new('_id' => id2) }
+
+  let(:key_vault) { [ key1, key2 ] }
+
+  let(:queries) { [] }
+
+  def filter(ids, alt_names = [])
+    BSON::Document.new('$or' => [
+      { '_id' => { '$in' => ids } },
+      { 'keyAltNames' => { '$in' => alt_names } },
+    ])
+  end
+
+  def fetch(query_filter)
+    cache.fetch(query_filter) do |query|
+      queries << query
+      ids = query['$or'][0]['_id']['$in']
+      alt_names = query['$or'][1]['keyAltNames']['$in']
+      key_vault.select do |key|
+        ids.include?(key['_id']) || ((key['keyAltNames'] || []) & alt_names).any?
+      end
+    end
+  end
+
+  it 'queries for keys which are not cached' do
+    expect(fetch(filter([ id1 ]))).to eq([ key1 ])
+    expect(queries.length).to eq(1)
+  end
+
+  it 'returns cached keys without querying' do
+    fetch(filter([ id1, id2 ]))
+    expect(fetch(filter([ id2 ]))).to eq([ key2 ])
+    expect(fetch(filter([], [ 'first' ]))).to eq([ key1 ])
+    expect(queries.length).to eq(1)
+  end
+
+  it 'only queries for the missing keys' do
+    fetch(filter([ id1 ]))
+    expect(fetch(filter([ id1, id2 ]))).to match_array([ key1, key2 ])
+    expect(queries.last['$or'][0]['_id']['$in']).to eq([ id2 ])
+  end
+
+  context 'when the keys have expired' do
+    let(:ttl) { 0.01 }
+
+    it 'queries again' do
+      fetch(filter([ id1 ]))
+      sleep 0.02
+      fetch(filter([ id1 ]))
+      expect(queries.length).to eq(2)
+    end
+  end
+
+  context 'when the filter has an unexpected form' do
+    it 'passes the filter through' do
+      cache.fetch('_id' => id1) do |query|
+        queries << query
+        []
+      end
+      expect(queries).to eq([ { '_id' => id1 } ])
+    end
+  end
+
+  context 'when keys are looked up concurrently' do
+    it 'merges the lookups made while a query is in flight' do
+      started = Queue.new
+      release = Queue.new
+      first = Thread.new do
+        cache.fetch(filter([ id1 ])) do |query|
+          queries << query
+          started << true
+          release.pop
+          [ key1 ]
+        end
+      end
+      started.pop
+
+      waiters = [ id1, id2, id2 ].map do |id|
+        Thread.new { fetch(filter([ id ])) }
+      end
+      sleep 0.05
+      release << true
+
+      expect(first.value).to eq([ key1 ])
+      expect(waiters.map(&:value)).to eq([ [ key1 ], [ key2 ], [ key2 ] ])
+      # The first query, followed by a single query for id2.
+      expect(queries.length).to eq(2)
+    end
+  end
+end
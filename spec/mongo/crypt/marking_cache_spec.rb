@@ -0,0 +1,132 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::Crypt::MarkingCache do
+  let(:cache) { described_class.new(2) }
+
+  let(:schema) do
+    { 'properties' => { 'ssn' => { 'encrypt' => { 'bsonType' => 'string' } } } }
+  end
+
+  def command(filter, json_schema = schema)
+    BSON::Document.new(
+      'find' => 'users',
+      'filter' => filter,
+      'jsonSchema' => json_schema,
+      'isRemoteSchema' => false,
+    )
+  end
+
+  def response(cmd, placeholders)
+    BSON::Document.new(
+      'hasEncryptedPlaceholders' => placeholders,
+      'schemaRequiresEncryption' => true,
+      'result' => cmd.reject { |name, _| %w(jsonSchema isRemoteSchema).include?(name) },
+      'ok' => 1,
+    )
+  end
+
+  let(:calls) { [] }
+
+  def fetch(cmd, placeholders: false)
+    cache.fetch(cmd) do
+      calls << cmd
+      response(cmd, placeholders)
+    end
+  end
+
+  it 'sends the first command to mongocryptd' do
+    fetch(command('name' => 'Alice'))
+    expect(calls.length).to eq(1)
+  end
+
+  context 'when a command with the same shape did not need encryption' do
+    it 'returns the command without sending it' do
+      fetch(command('age' => 30))
+      result = fetch(command('age' => 31))
+      expect(calls.length).to eq(1)
+      expect(result['hasEncryptedPlaceholders']).to be false
+      expect(result['result']).to eq('find' => 'users', 'filter' => { 'age' => 31 })
+    end
+  end
+
+  context 'when a string value differs' do
+    it 'sends the command' do
+      fetch(command('name' => 'Alice'))
+      fetch(command('name' => 'Bob'))
+      expect(calls.length).to eq(2)
+    end
+  end
+
+  context 'when an expression references a different field' do
+    def expr_command(field)
+      command('$expr' => { '$eq' => [ field, '123-45-6789' ] })
+    end
+
+    it 'sends the command' do
+      fetch(expr_command('$name'))
+      result = fetch(expr_command('$ssn'), placeholders: true)
+      expect(calls.length).to eq(2)
+      expect(result['hasEncryptedPlaceholders']).to be true
+    end
+  end
+
+  context 'when distinct is on a different key' do
+    def distinct_command(key)
+      BSON::Document.new(
+        'distinct' => 'users',
+        'key' => key,
+        'query' => { 'age' => 30 },
+        'jsonSchema' => schema,
+        'isRemoteSchema' => false,
+      )
+    end
+
+    it 'sends the command' do
+      fetch(distinct_command('name'))
+      fetch(distinct_command('ssn'), placeholders: true)
+      expect(calls.length).to eq(2)
+    end
+  end
+
+  context 'when a command with the same shape needed encryption' do
+    it 'sends the command' do
+      fetch(command('ssn' => '123'), placeholders: true)
+      fetch(command('ssn' => '456'), placeholders: true)
+      expect(calls.length).to eq(2)
+    end
+  end
+
+  context 'when the shape differs' do
+    it 'sends the command' do
+      fetch(command('name' => 'Alice'))
+      fetch(command('name' => 1))
+      fetch(command('other' => 'Alice'))
+      expect(calls.length).to eq(3)
+    end
+  end
+
+  context 'when the schema differs' do
+    it 'sends the command' do
+      fetch(command('name' => 'Alice'))
+      fetch(command({ 'name' => 'Alice' }, { 'properties' => {} }))
+      expect(calls.length).to eq(2)
+    end
+  end
+
+  context 'when the cache is full' do
+    it 'evicts the least recently used response' do
+      fetch(command('a' => 1))
+      fetch(command('b' => 1))
+      fetch(command('a' => 2))
+      fetch(command('c' => 1))
+      fetch(command('a' => 3))
+      fetch(command('b' => 2))
+      expect(calls.map { |cmd| cmd['filter'] }).to eq([
+        { 'a' => 1 }, { 'b' => 1 }, { 'c' => 1 }, { 'b' => 2 },
+      ])
+    end
+  end
+end
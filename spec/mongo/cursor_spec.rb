@@ -697,4 +697,65 @@ describe Mongo::Cursor do
       end
     end
   end
+
+  context 'when prefetching' do
+    let(:subscriber) { Mrss::EventSubscriber.new }
+
+    let(:client) do
+      authorized_client.tap do |client|
+        client.subscribe(Mongo::Monitoring::COMMAND, subscriber)
+      end
+    end
+
+    let(:collection) do
+      client['cursor_spec_collection']
+    end
+
+    let(:view) do
+      collection.find({}, batch_size: 2, prefetch: true)
+    end
+
+    let(:get_more_events) do
+      subscriber.started_events.select { |event| event.command_name == 'getMore' }
+    end
+
+    before do
+      collection.insert_many((1..5).map { |i| { field: i } })
+    end
+
+    it 'returns all documents in order' do
+      view.to_a.map { |doc| doc['field'] }.should == [1, 2, 3, 4, 5]
+    end
+
+    it 'sends the next getMore before the current batch is consumed' do
+      view.to_enum.next
+      cursor = view.instance_variable_get(:@cursor)
+      cursor.instance_variable_get(:@prefetch_thread)&.join
+      get_more_events.length.should == 1
+    end
+
+    context 'when the cursor is closed with a prefetch outstanding' do
+      it 'closes the cursor' do
+        view.to_enum.next
+        cursor = view.instance_variable_get(:@cursor)
+        cursor.close
+        cursor.should be_closed
+        cursor.instance_variable_get(:@prefetch_thread).should be nil
+      end
+    end
+
+    context 'when using an explicit session' do
+      let(:session) { client.start_session }
+
+      let(:view) do
+        collection.find({}, batch_size: 2, prefetch: true, session: session)
+      end
+
+      it 'does not prefetch' do
+        enum = view.to_enum
+        enum.next
+        get_more_events.should be_empty
+      end
+    end
+  end
 end
@@ -690,6 +690,25 @@ describe Mongo::Grid::FSBucket do
         end
       end
 
+      context 'when given a byte range' do
+
+        let!(:file_id) do
+          fs.open_upload_stream(filename) do |stream|
+            stream.write(file)
+          end.file_id
+        end
+
+        before do
+          fs.download_to_stream(file_id, io, offset: 10, length: 20)
+        end
+
+        it 'writes the range to the provided stream' do
+          file.rewind
+          expect(io.size).to eq(20)
+          expect(io.string).to eq(file.read.byteslice(10, 20))
+        end
+      end
+
       context 'when there is no files collection document found' do
 
         it 'raises an exception' do
@@ -222,6 +222,107 @@ describe Mongo::Grid::FSBucket::Stream::Read do
     end
   end
 
+  describe '#write_to' do
+
+    let(:fs_options) do
+      { chunk_size: 5 }
+    end
+
+    let(:data) do
+      File.open(__FILE__, 'rb').read
+    end
+
+    let(:io) do
+      StringIO.new(String.new(encoding: BSON::BINARY))
+    end
+
+    it 'writes all data to the io' do
+      expect(stream.write_to(io)).to eq(data.bytesize)
+      expect(io.string).to eq(data)
+    end
+
+    context 'when given a range' do
+
+      it 'writes the requested bytes' do
+        expect(stream.write_to(io, offset: 7, length: 11)).to eq(11)
+        expect(io.string).to eq(data.byteslice(7, 11))
+      end
+
+      it 'queries only the chunks covering the range' do
+        expect(stream.send(:chunks_view, 1, 3).count).to eq(3)
+        expect(stream).to receive(:chunks_view).with(1, 3).and_call_original
+        stream.write_to(io, offset: 7, length: 11)
+      end
+
+      context 'when the range extends past the end of the file' do
+
+        it 'writes the data through the end of the file' do
+          stream.write_to(io, offset: data.bytesize - 3, length: 100)
+          expect(io.string).to eq(data.byteslice(-3, 3))
+        end
+      end
+
+      context 'when the offset is past the end of the file' do
+
+        it 'raises an ArgumentError' do
+          expect {
+            stream.write_to(io, offset: data.bytesize + 1)
+          }.to raise_error(ArgumentError)
+        end
+      end
+    end
+
+    context 'when the file has an extra chunk' do
+
+      before do
+        last_n = (data.bytesize + 4) / 5 - 1
+        fs.chunks_collection.insert_one(
+          files_id: file_id, n: last_n + 1, data: BSON::Binary.new('extra'),
+        )
+      end
+
+      it 'raises an exception' do
+        expect {
+          stream.write_to(io)
+        }.to raise_error(Mongo::Error::ExtraFileChunk)
+      end
+
+      it 'does not raise when the range ends before the last chunk' do
+        expect(stream.write_to(io, offset: 7, length: 11)).to eq(11)
+      end
+    end
+
+    context 'when reading ahead' do
+
+      let(:options) do
+        { file_id: file_id, read_ahead: 3 }
+      end
+
+      it 'writes all data to the io' do
+        stream.write_to(io)
+        expect(io.string).to eq(data)
+      end
+
+      it 'writes the requested range' do
+        stream.write_to(io, offset: 123, length: 456)
+        expect(io.string).to eq(data.byteslice(123, 456))
+      end
+
+      context 'when a chunk is missing' do
+
+        before do
+          fs.chunks_collection.delete_one(files_id: file_id, n: 20)
+        end
+
+        it 'raises an exception' do
+          expect {
+            stream.write_to(io)
+          }.to raise_error(Mongo::Error::MissingFileChunk)
+        end
+      end
+    end
+  end
+
   describe '#file_info' do
 
     it 'returns a files information document' do
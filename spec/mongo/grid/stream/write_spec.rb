@@ -465,6 +465,73 @@ describe Mongo::Grid::FSBucket::Stream::Write do
       end
     end
 
+    context 'when the source spans several insert batches' do
+
+      let(:extra_options) do
+        { chunk_size: 100 }
+      end
+
+      before do
+        stub_const("#{described_class}::INSERT_BATCH_BYTES", 250)
+      end
+
+      let(:chunks_documents) do
+        stream.fs.chunks_collection.find(files_id: stream.file_id).sort(n: 1).to_a
+      end
+
+      shared_examples 'a streaming upload' do
+
+        before do
+          stream.write(file)
+          stream.close
+        end
+
+        it 'writes the contents of the stream' do
+          expect(file_from_db.data).to eq(File.open(__FILE__, 'rb').read)
+        end
+
+        it 'writes chunks of the chunk size' do
+          expect(chunks_documents.length).to eq((file.size + 99) / 100)
+          expect(chunks_documents.map { |doc| doc['n'] }).to eq((0...chunks_documents.length).to_a)
+        end
+
+        it 'inserts the chunks in batches' do
+          expect(stream.instance_variable_get(:@n)).to eq(chunks_documents.length)
+        end
+      end
+
+      it_behaves_like 'a streaming upload'
+
+      context 'when inserting batches concurrently' do
+
+        let(:extra_options) do
+          { chunk_size: 100, max_in_flight: 3 }
+        end
+
+        it_behaves_like 'a streaming upload'
+
+        it 'does not store the option in the files document' do
+          stream.write(file)
+          stream.close
+          doc = stream.fs.files_collection.find(_id: stream.file_id).first
+          expect(doc).not_to have_key('max_in_flight')
+        end
+      end
+
+      context 'when max_in_flight is not positive' do
+
+        let(:extra_options) do
+          { max_in_flight: 0 }
+        end
+
+        it 'raises an ArgumentError' do
+          expect {
+            stream
+          }.to raise_error(ArgumentError, /Max in flight must be positive/)
+        end
+      end
+    end
+
     context 'when the stream is closed' do
 
       before do
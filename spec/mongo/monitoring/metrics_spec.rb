@@ -0,0 +1,155 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'spec_helper'
+
+describe Mongo::Monitoring::Metrics do
+
+  let(:metrics) do
+    described_class.new(options)
+  end
+
+  let(:options) do
+    {}
+  end
+
+  let(:address) do
+    Mongo::Address.new('127.0.0.1:27017')
+  end
+
+  describe '#initialize' do
+
+    context 'when the sample rate is out of range' do
+
+      let(:options) do
+        { sample_rate: 0 }
+      end
+
+      it 'raises an ArgumentError' do
+        expect {
+          metrics
+        }.to raise_error(ArgumentError, /sample rate/)
+      end
+    end
+  end
+
+  describe '#record_command' do
+
+    before do
+      metrics.record_command('find', address, 0.002, true)
+      metrics.record_command('find', address, 0.2, false)
+    end
+
+    let(:histogram) do
+      metrics.snapshot[:commands]['find'][address.seed]
+    end
+
+    it 'records the durations in a histogram' do
+      expect(histogram[:count]).to eq(2)
+      expect(histogram[:sum]).to be_within(1e-9).of(0.202)
+      expect(histogram[:buckets][0.001]).to eq(0)
+      expect(histogram[:buckets][0.0025]).to eq(1)
+      expect(histogram[:buckets][Float::INFINITY]).to eq(2)
+    end
+
+    it 'counts failures' do
+      expect(histogram[:failures]).to eq(1)
+    end
+
+    context 'when sampling' do
+
+      let(:options) do
+        { sample_rate: 0.5 }
+      end
+
+      before do
+        allow(metrics).to receive(:rand).and_return(0.7, 0.2)
+        metrics.record_command('insert', address, 0.01, false)
+        metrics.record_command('insert', address, 0.01, false)
+      end
+
+      let(:histogram) do
+        metrics.snapshot[:commands]['insert'][address.seed]
+      end
+
+      it 'records only sampled durations' do
+        expect(histogram[:count]).to eq(1)
+      end
+
+      it 'counts all failures' do
+        expect(histogram[:failures]).to eq(2)
+      end
+    end
+  end
+
+  describe 'pool metrics' do
+
+    before do
+      metrics.record_connection_created(address, 0.01)
+      metrics.record_check_out(address, 0.0001)
+      metrics.record_check_out(address, 0.0001)
+      metrics.record_check_in(address)
+    end
+
+    let(:pool) do
+      metrics.snapshot[:pools][address.seed]
+    end
+
+    it 'tracks the number of checked out connections' do
+      expect(pool[:checked_out]).to eq(1)
+    end
+
+    it 'records check out durations' do
+      expect(pool[:check_out_duration][:count]).to eq(2)
+    end
+
+    it 'records connection creation' do
+      expect(pool[:connections_created]).to eq(1)
+      expect(pool[:connection_creation_duration][:count]).to eq(1)
+    end
+  end
+
+  describe '#to_prometheus' do
+
+    before do
+      metrics.record_command('find', address, 0.002, true)
+      metrics.record_check_out(address, 0.0001)
+    end
+
+    let(:text) do
+      metrics.to_prometheus
+    end
+
+    it 'exports the command histogram' do
+      expect(text).to include(%(mongo_command_duration_seconds_bucket{command="find",server="#{address.seed}",le="0.0025"} 1))
+      expect(text).to include(%(mongo_command_duration_seconds_bucket{command="find",server="#{address.seed}",le="+Inf"} 1))
+      expect(text).to include(%(mongo_command_duration_seconds_count{command="find",server="#{address.seed}"} 1))
+    end
+
+    it 'exports the pool gauge' do
+      expect(text).to include(%(mongo_pool_checked_out_connections{server="#{address.seed}"} 1))
+    end
+  end
+
+  context 'when enabled on a client' do
+
+    let(:client) do
+      new_local_client(SpecConfig.instance.addresses,
+        SpecConfig.instance.test_options.merge(metrics: true))
+    end
+
+    it 'records commands and pool metrics' do
+      client['metrics_spec'].find.first
+      snapshot = client.metrics.snapshot
+      expect(snapshot[:commands]['find'].values.first[:count]).to be >= 1
+      expect(snapshot[:pools].values.first[:checked_out]).to eq(0)
+    end
+  end
+
+  context 'when not enabled on a client' do
+
+    it 'is not available' do
+      expect(authorized_client.metrics).to be nil
+    end
+  end
+end
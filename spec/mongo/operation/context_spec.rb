@@ -0,0 +1,59 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::Operation::Context do
+  describe '#remaining_timeout_sec' do
+    context 'when timeout_ms is not given' do
+      let(:context) { described_class.new }
+
+      it 'returns nil' do
+        expect(context.timeout?).to be false
+        expect(context.remaining_timeout_sec).to be nil
+      end
+    end
+
+    context 'when timeout_ms is zero' do
+      let(:context) { described_class.new(timeout_ms: 0) }
+
+      it 'returns nil' do
+        expect(context.timeout?).to be false
+        expect(context.remaining_timeout_sec).to be nil
+      end
+    end
+
+    context 'when timeout_ms is given' do
+      let(:context) { described_class.new(timeout_ms: 10_000) }
+
+      it 'returns the time remaining' do
+        expect(context.timeout?).to be true
+        expect(context.remaining_timeout_sec).to be_within(1).of(10)
+      end
+    end
+
+    context 'when the client has the timeout_ms option' do
+      let(:client) { double('client', options: { timeout_ms: 10_000 }) }
+      let(:context) { described_class.new(client: client) }
+
+      it 'uses the option' do
+        expect(context.remaining_timeout_sec).to be_within(1).of(10)
+      end
+    end
+
+    context 'when the deadline has passed' do
+      let(:context) { described_class.new(timeout_ms: 1) }
+
+      before do
+        sleep 0.01
+      end
+
+      it 'raises TimeoutError' do
+        expect(context.deadline_expired?).to be true
+        expect do
+          context.remaining_timeout_sec
+        end.to raise_error(Mongo::Error::TimeoutError, /timeout_ms/)
+      end
+    end
+  end
+end
@@ -39,6 +39,18 @@ describe Mongo::Protocol::Compressed do
         expect(Zstd).to receive(:compress).with(original_message_bytes).and_call_original
         message.serialize
       end
+
+      context 'when zstd compression level is provided' do
+
+        let(:message) do
+          described_class.new(original_message, compressor, nil, 3)
+        end
+
+        it 'uses the compression level' do
+          expect(Zstd).to receive(:compress).with(original_message_bytes, 3).and_call_original
+          message.serialize
+        end
+      end
     end
 
     context 'when zlib compression level is not provided' do
@@ -60,6 +72,24 @@ describe Mongo::Protocol::Compressed do
     end
   end
 
+  describe '#serialize_from' do
+
+    let(:serialized_original) do
+      original_message.serialize
+    end
+
+    it 'produces the same bytes as #serialize' do
+      expected = described_class.new(original_message, compressor, level).serialize.to_s
+      expect(message.serialize_from(serialized_original).to_s).to eq(expected)
+    end
+
+    it 'does not serialize the original message again' do
+      serialized_original
+      expect(original_message).not_to receive(:serialize_fields)
+      message.serialize_from(serialized_original)
+    end
+  end
+
   describe '#replyable?' do
 
     context 'when the original message is replyable' do
@@ -440,6 +440,89 @@ describe Mongo::Protocol::Msg do
     end
   end
 
+  describe '#serialize_segments' do
+
+    let(:main_document) { { insert: 'test' } }
+
+    let(:sequences) do
+      [
+        Mongo::Protocol::Msg::Section1.new('documents', [ { a: 1 }, { a: 2 } ]),
+        Mongo::Protocol::Msg::Section1.new('documents', [ { a: 3 } ]),
+      ]
+    end
+
+    let(:segments) { message.serialize_segments }
+
+    it 'returns the header and one segment per section' do
+      expect(segments.length).to eq(4)
+      expect(segments.first.length).to eq(20)
+    end
+
+    it 'produces the same bytes as #serialize' do
+      expect(segments.map(&:to_s).join).to eq(message.serialize.to_s)
+    end
+
+    it 'sets the total message length in the header' do
+      expect(segments.first.to_s[0..3]).to be_int32(segments.sum(&:length))
+    end
+
+    it 'serializes the sections only once' do
+      message.serialize
+      expect(Mongo::Protocol::Serializers::Sections).not_to receive(:serialize)
+      expect(segments.map(&:to_s).join).to eq(message.serialize.to_s)
+    end
+
+    context 'when a document is too large' do
+
+      let(:sequences) do
+        [ Mongo::Protocol::Msg::Section1.new('documents', [ { a: 'x' * 100 } ]) ]
+      end
+
+      it 'raises MaxBSONSize' do
+        expect do
+          message.serialize_segments(50)
+        end.to raise_error(Mongo::Error::MaxBSONSize)
+      end
+    end
+
+    it 'does not copy the serialized sections' do
+      expect(message.serialize_segments.drop(1).map(&:object_id)).to eq(segments.drop(1).map(&:object_id))
+      expect(segments.drop(1)).to all(be_frozen)
+    end
+  end
+
+  describe '#command_name' do
+
+    let(:main_document) { { ping: 1, '$db' => 'admin' } }
+
+    it 'returns the first key of the main document' do
+      expect(message.command_name).to eq('ping')
+    end
+
+    context 'when the main document is empty' do
+
+      let(:main_document) { {} }
+
+      it 'returns an empty string' do
+        expect(message.command_name).to eq('')
+      end
+    end
+  end
+
+  describe 'main document' do
+
+    let(:main_document) { { ping: 1 } }
+
+    it 'is frozen' do
+      expect(message.documents.first).to be_frozen
+    end
+
+    it 'does not freeze the given document' do
+      message
+      expect(main_document).not_to be_frozen
+    end
+  end
+
   describe '#deserialize' do
 
     context 'when the payload type is valid' do
@@ -283,5 +283,119 @@ describe Mongo::QueryCache do
       Mongo::QueryCache.clear_namespace(namespace1)
       expect(Mongo::QueryCache.send(:cache_table)[nil]).to be_nil
     end
+
+    context 'when the namespaces of a multi collection query are known' do
+      before do
+        Mongo::QueryCache.set(caching_cursor, namespace: namespace1,
+          selector: [{ '$lookup' => { 'from' => 'coll2' } }],
+          multi_collection: true, namespaces: [namespace1, namespace2])
+      end
+
+      it 'does not clear the query on writes to other namespaces' do
+        Mongo::QueryCache.clear_namespace(namespace3)
+        expect(Mongo::QueryCache.send(:cache_table)[nil].length).to eq(1)
+      end
+
+      it 'clears the query on writes to its namespaces' do
+        Mongo::QueryCache.clear_namespace(namespace2)
+        expect(Mongo::QueryCache.send(:cache_table)[nil]).to be_nil
+      end
+    end
+  end
+
+  describe '#max_entries=' do
+    let(:selector) { { field: 'value' } }
+
+    around do |spec|
+      Mongo::QueryCache.max_entries = 2
+      begin
+        spec.run
+      ensure
+        Mongo::QueryCache.max_entries = nil
+      end
+    end
+
+    let(:cursors) do
+      3.times.map do |i|
+        double("Mongo::CachingCursor").tap do |cursor|
+          allow(cursor).to receive_message_chain(:view, :limit).and_return(nil)
+        end
+      end
+    end
+
+    it 'evicts the least recently used cursor' do
+      Mongo::QueryCache.set(cursors[0], namespace: 'db.coll0', selector: selector)
+      Mongo::QueryCache.set(cursors[1], namespace: 'db.coll1', selector: selector)
+      # Use the first cursor, making the second one the least recently used.
+      expect(Mongo::QueryCache.get(namespace: 'db.coll0', selector: selector)).to eq(cursors[0])
+      Mongo::QueryCache.set(cursors[2], namespace: 'db.coll2', selector: selector)
+
+      expect(Mongo::QueryCache.get(namespace: 'db.coll0', selector: selector)).to eq(cursors[0])
+      expect(Mongo::QueryCache.get(namespace: 'db.coll1', selector: selector)).to be_nil
+      expect(Mongo::QueryCache.get(namespace: 'db.coll2', selector: selector)).to eq(cursors[2])
+      expect(Mongo::QueryCache.stats[:evictions]).to eq(1)
+      expect(Mongo::QueryCache.stats[:size]).to eq(2)
+    end
+
+    it 'rejects non-positive values' do
+      expect do
+        Mongo::QueryCache.max_entries = 0
+      end.to raise_error(ArgumentError)
+    end
+  end
+
+  describe '#stats' do
+
+    before do
+      authorized_collection.insert_one({ name: 'testing' })
+    end
+
+    it 'counts hits and misses' do
+      stats = Mongo::QueryCache.stats
+      2.times { authorized_collection.find(name: 'testing').to_a }
+      expect(Mongo::QueryCache.stats[:misses]).to eq(stats[:misses] + 1)
+      expect(Mongo::QueryCache.stats[:hits]).to eq(stats[:hits] + 1)
+      expect(events.length).to eq(1)
+    end
+  end
+
+  describe '#shared_namespaces=' do
+
+    around do |spec|
+      Mongo::QueryCache.shared_namespaces = [authorized_collection.namespace]
+      begin
+        spec.run
+      ensure
+        Mongo::QueryCache.shared_namespaces = nil
+        Mongo::QueryCache.clear_shared
+      end
+    end
+
+    before do
+      authorized_collection.insert_one({ name: 'testing' })
+      authorized_collection.find(name: 'testing').to_a
+    end
+
+    it 'serves the query in other threads' do
+      Thread.new do
+        Mongo::QueryCache.cache do
+          authorized_collection.find(name: 'testing').to_a
+        end
+      end.join
+      expect(events.length).to eq(1)
+      expect(Mongo::QueryCache.shared_stats[:hits]).to eq(1)
+    end
+
+    it 'is not cleared by clear' do
+      Mongo::QueryCache.clear
+      authorized_collection.find(name: 'testing').to_a
+      expect(events.length).to eq(1)
+    end
+
+    it 'is cleared by writes' do
+      authorized_collection.insert_one({ name: 'testing' })
+      authorized_collection.find(name: 'testing').to_a
+      expect(events.length).to eq(2)
+    end
   end
 end
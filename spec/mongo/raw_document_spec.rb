@@ -0,0 +1,178 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::RawDocument do
+
+  let(:document) do
+    BSON::Document.new(
+      _id: BSON::ObjectId.new,
+      name: 'test',
+      count: 42,
+      nested: { a: [1, 2, 3] },
+      pattern: BSON::Regexp::Raw.new('^ab', 'i'),
+      blob: BSON::Binary.new('abc'),
+      nothing: nil,
+    )
+  end
+
+  let(:bytes) { document.to_bson.to_s }
+
+  let(:raw) { described_class.new(bytes) }
+
+  describe '#[]' do
+
+    it 'returns the value of the field' do
+      expect(raw['count']).to eq(42)
+      expect(raw['nested']).to eq('a' => [1, 2, 3])
+    end
+
+    it 'accepts symbol keys' do
+      expect(raw[:name]).to eq('test')
+    end
+
+    it 'returns nil for missing fields' do
+      expect(raw['missing']).to be nil
+    end
+
+    it 'does not deserialize the entire document' do
+      expect(BSON::Document).to receive(:from_bson).once.and_call_original
+      raw['name']
+    end
+  end
+
+  describe '#keys' do
+
+    it 'returns the field names in order' do
+      expect(raw.keys).to eq(%w(_id name count nested pattern blob nothing))
+    end
+  end
+
+  describe '#key?' do
+
+    it 'returns whether the field is present' do
+      expect(raw.key?(:nothing)).to be true
+      expect(raw.key?('missing')).to be false
+    end
+  end
+
+  describe '#fetch' do
+
+    it 'raises KeyError for missing fields' do
+      expect do
+        raw.fetch('missing')
+      end.to raise_error(KeyError)
+    end
+
+    it 'returns the default for missing fields' do
+      expect(raw.fetch('missing', 1)).to eq(1)
+    end
+  end
+
+  describe '#to_h' do
+
+    it 'deserializes the document' do
+      expect(raw.to_h).to eq(document)
+    end
+  end
+
+  describe '#bson_bytes' do
+
+    context 'when the document is embedded in a larger string' do
+
+      let(:raw) { described_class.new('prefix'.b + bytes + 'suffix', 6) }
+
+      it 'returns the bytes of the document' do
+        expect(raw.bson_bytes).to eq(bytes)
+      end
+    end
+  end
+
+  describe '#to_bson' do
+
+    it 'writes the document bytes' do
+      expect(raw.to_bson.to_s).to eq(bytes)
+    end
+
+    it 'can be embedded in other documents' do
+      outer = { doc: raw }.to_bson.to_s
+      expect(BSON::Document.from_bson(BSON::ByteBuffer.new(outer))).to eq('doc' => document)
+    end
+  end
+
+  describe '#to_extended_json' do
+
+    let(:document) do
+      BSON::Document.new(
+        _id: BSON::ObjectId.new,
+        name: "t\u00e9st \"quoted\"",
+        count: 42,
+        big: 2**40,
+        ratio: 0.25,
+        infinite: Float::INFINITY,
+        flag: true,
+        nested: { a: [1, 'two', { b: nil }], empty: {} },
+        blob: BSON::Binary.new('abc'),
+        at: Time.utc(2021, 3, 4, 5, 6, 7),
+      )
+    end
+
+    it 'matches the relaxed extended JSON produced by bson-ruby' do
+      expect(JSON.parse(raw.to_extended_json)).to eq(
+        JSON.parse(document.as_extended_json(mode: :relaxed).to_json))
+    end
+
+    it 'does not deserialize the common types' do
+      doc = BSON::Document.new(_id: BSON::ObjectId.new, name: 'test', nested: { a: [1, 2.5] })
+      expect(BSON::Document).not_to receive(:from_bson)
+      described_class.new(doc.to_bson.to_s).to_extended_json
+    end
+
+    it 'returns a UTF-8 string' do
+      expect(raw.to_extended_json.encoding).to eq(Encoding::UTF_8)
+    end
+
+    context 'when the bson gem cannot convert a value to extended JSON' do
+      before do
+        allow_any_instance_of(BSON::Binary).to receive(:respond_to?).and_call_original
+        allow_any_instance_of(BSON::Binary).to receive(:respond_to?).with(:as_extended_json).and_return(false)
+      end
+
+      it 'raises UnmetDependency' do
+        expect do
+          raw.to_extended_json
+        end.to raise_error(Mongo::Error::UnmetDependency, /BSON::Binary/)
+      end
+    end
+  end
+
+  describe '.deserialize_reply' do
+
+    let(:reply) do
+      {
+        cursor: {
+          firstBatch: [ { a: 1 }, { a: 2 } ],
+          id: 0,
+          ns: 'test.test',
+        },
+        ok: 1,
+      }
+    end
+
+    let(:deserialized) do
+      described_class.deserialize_reply(reply.to_bson)
+    end
+
+    it 'deserializes non-batch fields' do
+      expect(deserialized['ok']).to eq(1)
+      expect(deserialized['cursor']['ns']).to eq('test.test')
+    end
+
+    it 'keeps batch documents raw' do
+      batch = deserialized['cursor']['firstBatch']
+      expect(batch).to all be_a(described_class)
+      expect(batch.map { |doc| doc['a'] }).to eq([1, 2])
+    end
+  end
+end
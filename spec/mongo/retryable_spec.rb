@@ -86,6 +86,21 @@ class RetryableHost
   public :retry_write_allowed?
 end
 
+class HedgedReadHost
+  include Mongo::Retryable
+
+  def initialize(client, cluster)
+    @client = client
+    @cluster = cluster
+  end
+
+  attr_reader :client
+  attr_reader :cluster
+
+  public :hedged_read
+  public :hedge_read?
+end
+
 describe Mongo::Retryable do
 
   let(:operation) do
@@ -263,6 +278,130 @@ describe Mongo::Retryable do
     end
   end
 
+  describe '#hedged_read' do
+    let(:retryable) { HedgedReadHost.new(client, cluster) }
+
+    let(:options) { { hedged_reads: true, hedged_read_delay: 0.05 } }
+
+    let(:first) { double('first server', p90_round_trip_time: 0.001) }
+    let(:second) { double('second server', p90_round_trip_time: 0.001) }
+
+    let(:server_selector) do
+      double('server_selector').tap do |selector|
+        allow(selector).to receive(:suitable_servers).and_return([ first, second ])
+      end
+    end
+
+    let(:session) { double('session', end_session: nil) }
+
+    let(:hedge_session) { double('hedge session', end_session: nil) }
+
+    let(:context) { Mongo::Operation::Context.new(client: client, session: session) }
+
+    let(:view) do
+      double('view',
+        collection: double('collection', name: 'test'),
+        database: double('database', name: 'db'),
+      )
+    end
+
+    let(:killed) { Queue.new }
+
+    before do
+      allow(client).to receive(:options).and_return(options)
+      allow(client).to receive(:get_session).with(implicit: true).and_return(hedge_session)
+      allow_any_instance_of(Mongo::Operation::KillCursors).to receive(:execute) do |op, server, context:|
+        killed << [ server, op.spec[:cursor_ids], context.session ]
+      end
+    end
+
+    def hedged_read(&block)
+      retryable.hedged_read(first, server_selector, context, view, &block)
+    end
+
+    context 'when the first server replies within the delay' do
+      it 'only queries the first server' do
+        queried = []
+        result, server, attempt_context = hedged_read do |target|
+          queried << target
+          double('result', cursor_id: 0)
+        end
+        expect(server).to be first
+        expect(queried).to eq([ first ])
+        expect(attempt_context.session).to be session
+        expect(client).not_to have_received(:get_session)
+      end
+    end
+
+    context 'when the first server is slow' do
+      it 'uses the reply of the second server and kills the other cursor' do
+        sessions = {}
+        result, server, attempt_context = hedged_read do |target, query_context|
+          sessions[target] = query_context.session
+          sleep(target.equal?(first) ? 0.3 : 0)
+          double('result', cursor_id: target.equal?(first) ? 1 : 2)
+        end
+        expect(server).to be second
+        expect(result.cursor_id).to eq(2)
+        expect(sessions).to eq(first => session, second => hedge_session)
+        expect(attempt_context.session).to be hedge_session
+        expect(killed.pop).to eq([ first, [ 1 ], session ])
+        expect(session).to have_received(:end_session)
+        expect(hedge_session).not_to have_received(:end_session)
+      end
+    end
+
+    context 'when the first server fails after the delay' do
+      it 'uses the reply of the second server' do
+        result, server = hedged_read do |target|
+          sleep 0.1
+          raise Mongo::Error::SocketError, 'failed' if target.equal?(first)
+          double('result', cursor_id: 0)
+        end
+        expect(server).to be second
+      end
+    end
+
+    context 'when both servers fail' do
+      it 'raises the error of the first server' do
+        expect do
+          hedged_read do |target|
+            sleep 0.1
+            raise Mongo::Error::SocketError, target.equal?(first) ? 'first' : 'second'
+          end
+        end.to raise_error(Mongo::Error::SocketError, 'first')
+        expect(hedge_session).to have_received(:end_session)
+        expect(session).not_to have_received(:end_session)
+      end
+    end
+  end
+
+  describe '#hedge_read?' do
+    let(:retryable) { HedgedReadHost.new(client, cluster) }
+
+    let(:server_selector) { Mongo::ServerSelector.get(mode: :nearest) }
+
+    before do
+      allow(client).to receive(:options).and_return(hedged_reads: true)
+    end
+
+    context 'when the session is implicit' do
+      let(:session) { double('session', implicit?: true, in_transaction?: false) }
+
+      it 'returns true' do
+        expect(retryable.hedge_read?(session, server_selector)).to be true
+      end
+    end
+
+    context 'when the session is explicit' do
+      let(:session) { double('session', implicit?: false, in_transaction?: false) }
+
+      it 'returns false' do
+        expect(retryable.hedge_read?(session, server_selector)).to be false
+      end
+    end
+  end
+
   describe '#retry_write_allowed?' do
     let(:retryable) { RetryableHost.new }
 
@@ -170,6 +170,36 @@ describe Mongo::Server::ConnectionPool do
     end
   end
 
+  describe '#max_connecting' do
+    context 'when the max connecting option is provided' do
+      let(:options) do
+        { max_connecting: 4 }
+      end
+
+      it 'returns the max connecting' do
+        expect(pool.max_connecting).to eq(4)
+      end
+    end
+
+    context 'when the max connecting option is not provided' do
+      it 'returns the default max connecting' do
+        expect(pool.max_connecting).to eq(2)
+      end
+    end
+
+    context 'when the max connecting option is not positive' do
+      let(:options) do
+        { max_connecting: 0 }
+      end
+
+      it 'raises ArgumentError' do
+        expect do
+          pool
+        end.to raise_error(ArgumentError, /Max connecting must be positive/)
+      end
+    end
+  end
+
   describe '#wait_timeout' do
     context 'when the wait timeout option is provided' do
       let (:options) do
@@ -558,6 +588,63 @@ describe Mongo::Server::ConnectionPool do
       end
     end
 
+    context 'when a thread is waiting for a connection at max size' do
+      let(:options) do
+        { max_pool_size: 1 }
+      end
+
+      let!(:connection) { pool.check_out }
+
+      it 'hands the checked in connection to the waiting thread' do
+        waiter = Thread.new { pool.check_out }
+        sleep 0.1 until waiter.status == 'sleep'
+
+        pool.check_in(connection)
+        expect(waiter.value).to be(connection)
+        expect(pool.size).to eq(1)
+      end
+    end
+
+    context 'when max_connecting connections are being established' do
+      let(:options) do
+        { max_pool_size: 3, max_connecting: 1, wait_queue_timeout: 0.5 }
+      end
+
+      let(:connecting) do
+        double('connection').tap do |connection|
+          allow(connection).to receive(:closed?).and_return(false)
+        end
+      end
+
+      before do
+        pool.instance_variable_get(:@pending_connections) << connecting
+      end
+
+      after do
+        pool.instance_variable_get(:@pending_connections).delete(connecting)
+      end
+
+      it 'waits instead of creating another connection' do
+        expect(Mongo::Server::Connection).not_to receive(:new)
+        expect do
+          pool.check_out
+        end.to raise_error(Mongo::Error::ConnectionCheckOutTimeout)
+      end
+    end
+
+    context 'when an available connection is reused' do
+      let!(:connection) do
+        pool.check_out.tap do |connection|
+          pool.check_in(connection)
+        end
+      end
+
+      it 'does not attempt to connect it again' do
+        expect(pool).not_to receive(:connect_connection)
+        expect(pool.check_out).to be(connection)
+      end
+    end
+
     context 'when pool is closed' do
       before do
         pool.close
@@ -1024,6 +1024,59 @@ describe Mongo::Server::Connection do
 =end
   end
 
+  describe '#serialize_segments' do
+
+    let(:connection) do
+      described_class.new(server, server.options.merge(compression_threshold: 1000))
+    end
+
+    let(:description) do
+      double('description').tap do |description|
+        allow(description).to receive(:max_bson_object_size).and_return(nil)
+        allow(description).to receive(:max_message_size).and_return(nil)
+      end
+    end
+
+    let(:context) { Mongo::Operation::Context.new }
+
+    let(:message) do
+      Mongo::Protocol::Msg.new([], {}, { insert: 'test', '$db' => 'test' },
+        Mongo::Protocol::Msg::Section1.new('documents', documents))
+    end
+
+    let(:segments) do
+      connection.send(:serialize_segments, message, context)
+    end
+
+    let(:op_code) do
+      segments.first.to_s[12..15].unpack1('l<')
+    end
+
+    before do
+      allow(connection).to receive(:description).and_return(description)
+      allow(connection).to receive(:compressor).and_return('zlib')
+    end
+
+    context 'when the message is smaller than the compression threshold' do
+
+      let(:documents) { [ { a: 1 } ] }
+
+      it 'does not compress the message' do
+        expect(op_code).to eq(Mongo::Protocol::Msg::OP_CODE)
+      end
+    end
+
+    context 'when the message is larger than the compression threshold' do
+
+      let(:documents) { [ { a: 'x' * 2000 } ] }
+
+      it 'compresses the message' do
+        expect(op_code).to eq(Mongo::Protocol::Compressed::OP_CODE)
+        expect(segments.length).to eq(1)
+      end
+    end
+  end
+
   describe '#initialize' do
 
     context 'when host and port are provided' do
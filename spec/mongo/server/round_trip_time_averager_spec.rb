@@ -25,6 +25,43 @@ describe Mongo::Server::RoundTripTimeAverager do
     end
   end
 
+  describe '#update_round_trip_time_window' do
+    let(:samples) { [0.5, 0.1, 0.3, 0.2, 0.4, 0.9, 0.6, 0.8, 0.7, 1.0] }
+
+    before do
+      samples.each do |rtt|
+        averager.instance_variable_set('@last_round_trip_time', rtt)
+        averager.send(:update_round_trip_time_window)
+      end
+    end
+
+    it 'computes the minimum rtt' do
+      expect(averager.min_round_trip_time).to eq(0.1)
+    end
+
+    it 'computes the 90th percentile rtt' do
+      expect(averager.p90_round_trip_time).to eq(0.9)
+    end
+
+    context 'when more samples than the window size are recorded' do
+      let(:samples) { [0.01] + [0.5] * 9 + [2.0] }
+
+      it 'discards the oldest samples' do
+        expect(averager.min_round_trip_time).to eq(0.5)
+        expect(averager.p90_round_trip_time).to eq(0.5)
+      end
+    end
+
+    context 'with a single sample' do
+      let(:samples) { [0.3] }
+
+      it 'uses the sample' do
+        expect(averager.min_round_trip_time).to eq(0.3)
+        expect(averager.p90_round_trip_time).to eq(0.3)
+      end
+    end
+  end
+
   describe '#measure' do
     context 'block does not raise' do
       it 'updates average rtt' do
@@ -0,0 +1,88 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'spec_helper'
+
+describe Mongo::Server::SharedMonitor do
+  require_topology :single, :replica_set, :sharded
+
+  before(:all) do
+    ClientRegistry.instance.close_all_clients
+  end
+
+  let(:options) do
+    SpecConfig.instance.test_options.merge(shared_monitoring: true)
+  end
+
+  let(:client) do
+    new_local_client(SpecConfig.instance.addresses, options)
+  end
+
+  let(:other_client) do
+    new_local_client(SpecConfig.instance.addresses, options)
+  end
+
+  def monitors_for(client)
+    client.cluster.servers_list.map do |server|
+      server.monitor.shared_monitor
+    end
+  end
+
+  it 'monitors the servers of both clients with one monitor per server' do
+    client.database.command(ping: 1)
+    other_client.database.command(ping: 1)
+
+    expect(client.cluster.servers_list).not_to be_empty
+    monitors_for(client).zip(monitors_for(other_client)).each do |monitor, other_monitor|
+      expect(monitor).to be_a(described_class)
+      expect(other_monitor).to equal(monitor)
+      expect(monitor.servers.length).to eq(2)
+    end
+  end
+
+  it 'delivers check results to both clients' do
+    client.database.command(ping: 1)
+    other_client.cluster.next_primary
+
+    other_client.cluster.servers_list.each do |server|
+      expect(server.monitor).to be_running
+    end
+    expect(other_client.cluster.servers_list.map(&:description)).to all(satisfy { |desc| !desc.unknown? })
+  end
+
+  context 'when one of the clients is closed' do
+    it 'keeps monitoring the servers of the other client' do
+      client.database.command(ping: 1)
+      other_client.database.command(ping: 1)
+      monitors = monitors_for(client)
+
+      client.close
+      monitors.each do |monitor|
+        expect(monitor.monitor).to be_running
+        expect(monitor.servers.length).to eq(1)
+      end
+
+      other_client.close
+      monitors.each do |monitor|
+        expect(monitor.monitor).not_to be_running
+        expect(described_class.monitors).not_to include(monitor)
+      end
+    end
+  end
+
+  context 'when options affecting monitoring differ' do
+    let(:other_client) do
+      new_local_client(SpecConfig.instance.addresses,
+        options.merge(heartbeat_frequency: 7))
+    end
+
+    it 'uses separate monitors' do
+      client.database.command(ping: 1)
+      other_client.database.command(ping: 1)
+
+      monitors_for(client).zip(monitors_for(other_client)).each do |monitor, other_monitor|
+        expect(other_monitor).not_to equal(monitor)
+      end
+    end
+  end
+end
@@ -133,6 +133,54 @@ describe Mongo::ServerSelector::SecondaryPreferred do
 
   end
 
+  describe '#try_select_server' do
+    let(:cluster) do
+      double('cluster').tap do |cluster|
+        allow(cluster).to receive(:options).and_return(server_selection_strategy: :power_of_two_choices)
+      end
+    end
+
+    let(:busy_secondary) do
+      make_server(:secondary, address: Mongo::Address.new('busy.host')).tap do |server|
+        allow(server).to receive(:operation_count).and_return(5)
+      end
+    end
+
+    let(:idle_secondary) do
+      make_server(:secondary, address: Mongo::Address.new('idle.host')).tap do |server|
+        allow(server).to receive(:operation_count).and_return(0)
+      end
+    end
+
+    let(:idle_primary) do
+      make_server(:primary).tap do |server|
+        allow(server).to receive(:operation_count).and_return(0)
+      end
+    end
+
+    before do
+      allow(selector).to receive(:suitable_servers).and_return(servers)
+    end
+
+    context 'with the power of two choices strategy' do
+      let(:servers) { [busy_secondary, idle_secondary, idle_primary] }
+
+      it 'selects the less loaded secondary' do
+        10.times do
+          expect(selector.try_select_server(cluster)).to be(idle_secondary)
+        end
+      end
+
+      context 'when there is a single secondary' do
+        let(:servers) { [busy_secondary, idle_primary] }
+
+        it 'selects the secondary' do
+          expect(selector.try_select_server(cluster)).to be(busy_secondary)
+        end
+      end
+    end
+  end
+
   describe '#select_in_replica_set' do
     context 'no candidates' do
       let(:candidates) { [] }
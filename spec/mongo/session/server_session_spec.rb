@@ -18,6 +18,24 @@ describe Mongo::Session::ServerSession do
     end
   end
 
+  describe '#idle_time' do
+
+    let(:server_session) do
+      described_class.new
+    end
+
+    it 'returns the time since the last use' do
+      sleep 0.1
+      expect(server_session.idle_time).to be_within(0.05).of(0.1)
+    end
+
+    it 'is reset when the session is used' do
+      sleep 0.1
+      server_session.set_last_use!
+      expect(server_session.idle_time).to be < 0.05
+    end
+  end
+
   describe '#next_txn_number' do
 
     it 'advances and returns the next transaction number' do
@@ -103,8 +103,8 @@ describe Mongo::Session::SessionPool do
       before do
         pool.checkin(old_session_a)
         pool.checkin(old_session_b)
-        allow(old_session_a).to receive(:last_use).and_return(Time.now - 1800)
-        allow(old_session_b).to receive(:last_use).and_return(Time.now - 1800)
+        allow(old_session_a).to receive(:idle_time).and_return(1800)
+        allow(old_session_b).to receive(:idle_time).and_return(1800)
       end
 
       context 'when a session is checked out' do
@@ -132,8 +132,8 @@ describe Mongo::Session::SessionPool do
       end
 
       before do
-        allow(old_session_a).to receive(:last_use).and_return(Time.now - 1800)
-        allow(old_session_b).to receive(:last_use).and_return(Time.now - 1800)
+        allow(old_session_a).to receive(:idle_time).and_return(1800)
+        allow(old_session_b).to receive(:idle_time).and_return(1800)
         pool.checkin(old_session_a)
         pool.checkin(old_session_b)
       end
@@ -146,6 +146,32 @@ describe Mongo::Session::SessionPool do
     end
   end
 
+  describe '#execute' do
+
+    let(:pool) do
+      described_class.new(cluster)
+    end
+
+    let!(:old_session) do
+      pool.checkout
+    end
+
+    let!(:new_session) do
+      pool.checkout
+    end
+
+    before do
+      pool.checkin(old_session)
+      pool.checkin(new_session)
+      allow(old_session).to receive(:idle_time).and_return(1800)
+    end
+
+    it 'removes the sessions about to expire' do
+      pool.execute
+      expect(pool.instance_variable_get(:@queue)).to eq([new_session])
+    end
+  end
+
   describe '#end_sessions' do
 
     let(:pool) do
@@ -55,6 +55,76 @@ describe Mongo::Socket do
     end
   end
 
+  describe '#read_from_socket' do
+    let(:raw_socket) { double('raw socket') }
+
+    let(:data) { ('x' * 100_000 + 'y' * 100_000).force_encoding('BINARY') }
+
+    let(:bufs) { [] }
+
+    before do
+      socket.instance_variable_set('@socket', raw_socket)
+      remaining = data.dup
+      allow(raw_socket).to receive(:read_nonblock) do |len, buf|
+        bufs << buf
+        buf.replace(remaining.slice!(0, [len, 10_000].min))
+      end
+    end
+
+    it 'reads the requested data in multiple chunks' do
+      expect(socket.send(:read_from_socket, data.length)).to eq(data)
+    end
+
+    it 'reuses the chunk buffer across reads' do
+      socket.send(:read_from_socket, 100_000)
+      socket.send(:read_from_socket, 100_000)
+      expect(bufs.map(&:object_id).uniq.length).to eq(1)
+    end
+
+    it 'does not return the reused chunk buffer' do
+      first = socket.send(:read_from_socket, 100_000)
+      socket.send(:read_from_socket, 100_000)
+      expect(first).to eq('x' * 100_000)
+    end
+  end
+
+  describe '#do_write' do
+    let(:raw_socket) { double('raw socket') }
+
+    let(:writes) { [] }
+
+    before do
+      socket.instance_variable_set('@socket', raw_socket)
+      allow(raw_socket).to receive(:write) do |data|
+        writes << data.dup
+        data.bytesize
+      end
+    end
+
+    def bytes(size)
+      ('x' * size).force_encoding('BINARY')
+    end
+
+    it 'writes small buffers in a single write' do
+      socket.send(:do_write, bytes(21), bytes(100), bytes(50))
+      expect(writes.map(&:bytesize)).to eq([ 171 ])
+    end
+
+    it 'sends small buffers with the start of a following large buffer' do
+      socket.send(:do_write, bytes(21), bytes(100_000))
+      expect(writes.map(&:bytesize)).to eq([
+        described_class::WRITE_CHUNK_SIZE,
+        100_021 - described_class::WRITE_CHUNK_SIZE,
+      ])
+    end
+
+    it 'writes the data in order' do
+      data = [ bytes(21), ('y' * 100_000).force_encoding('BINARY'), bytes(10) ]
+      socket.send(:do_write, *data)
+      expect(writes.join).to eq(data.join)
+    end
+  end
+
   describe '#read' do
     let(:target_host) do
       host = ClusterConfig.instance.primary_address_host
@@ -0,0 +1,128 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'lite_spec_helper'
+
+describe Mongo::Srv::Cache do
+  let(:record_class) { Struct.new(:name, :ttl) }
+
+  let(:records) { [ record_class.new('a', 100), record_class.new('b', 40) ] }
+
+  let(:key) { [ '_mongodb._tcp.test1.test.build.10gen.cc', Resolv::DNS::Resource::IN::SRV, nil ] }
+
+  let(:lookups) { [] }
+
+  let(:now) { [ 1000.0 ] }
+
+  before do
+    described_class.clear
+    allow(Mongo::Utils).to receive(:monotonic_time) { now.first }
+  end
+
+  after do
+    described_class.clear
+  end
+
+  def fetch(result = records)
+    described_class.fetch(key) do
+      lookups << Thread.current
+      result
+    end
+  end
+
+  it 'performs the lookup' do
+    expect(fetch).to eq(records)
+    expect(lookups.length).to eq(1)
+  end
+
+  context 'when the result is cached' do
+    before do
+      fetch
+    end
+
+    it 'returns the cached result' do
+      now[0] += 20
+      expect(fetch).to eq(records)
+      expect(lookups.length).to eq(1)
+    end
+
+    context 'when most of the smallest TTL has elapsed' do
+      it 'returns the cached result and refreshes it in the background' do
+        now[0] += 35
+        new_records = [ record_class.new('c', 100) ]
+        expect(fetch(new_records)).to eq(records)
+
+        10.times do
+          break if lookups.length == 2
+          sleep 0.1
+        end
+        expect(lookups.length).to eq(2)
+        expect(lookups.last).not_to eq(Thread.current)
+
+        10.times do
+          break if fetch == new_records
+          sleep 0.1
+        end
+        expect(fetch).to eq(new_records)
+        expect(lookups.length).to eq(2)
+      end
+    end
+
+    context 'when the smallest TTL has elapsed' do
+      it 'performs the lookup' do
+        now[0] += 40
+        fetch
+        expect(lookups.length).to eq(2)
+        expect(lookups.last).to eq(Thread.current)
+      end
+    end
+  end
+
+  context 'when the lookup returns no records' do
+    it 'caches the result for the negative TTL' do
+      fetch([])
+      now[0] += described_class::NEGATIVE_TTL - 1
+      expect(fetch([])).to eq([])
+      expect(lookups.length).to eq(1)
+
+      now[0] += 1
+      fetch([])
+      expect(lookups.length).to eq(2)
+    end
+  end
+
+  context 'when the lookup fails' do
+    it 'does not cache the failure' do
+      expect do
+        described_class.fetch(key) { raise Resolv::ResolvError, 'test' }
+      end.to raise_error(Resolv::ResolvError)
+
+      fetch
+      expect(lookups.length).to eq(1)
+    end
+  end
+
+  context 'when lookups are concurrent' do
+    it 'performs a single lookup' do
+      started = Queue.new
+      finish = Queue.new
+      first = Thread.new do
+        described_class.fetch(key) do
+          started << true
+          finish.pop
+          lookups << Thread.current
+          records
+        end
+      end
+      started.pop
+
+      second = Thread.new { fetch }
+      sleep 0.1
+      finish << true
+
+      expect(first.value).to eq(records)
+      expect(second.value).to eq(records)
+      expect(lookups.length).to eq(1)
+    end
+  end
+end
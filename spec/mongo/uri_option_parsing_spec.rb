@@ -392,6 +392,14 @@ describe Mongo::URI do
     end
   end
 
+  context 'maxConnecting' do
+
+    let(:uri_option) { 'maxConnecting' }
+    let(:ruby_option) { :max_connecting }
+
+    it_behaves_like 'an integer option'
+  end
+
   context 'maxPoolSize' do
 
     let(:uri_option) { 'maxPoolSize' }
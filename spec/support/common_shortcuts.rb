@@ -348,10 +348,13 @@ module CommonShortcuts
       end
 
       semaphore.wait
+      # Results of previous lookups are cached for the TTL of the records.
+      Mongo::Srv::Cache.clear
 
       begin
         yield
       ensure
+        Mongo::Srv::Cache.clear
         10.times do
           if $last_async_task
             break
@@ -0,0 +1,126 @@
+# frozen_string_literal: true
+# encoding: utf-8
+
+require 'io/wait'
+
+# A minimal fiber scheduler for testing the driver's fiber scheduler
+# support without depending on an event loop gem. Based on the test
+# scheduler in the Ruby source tree.
+class TestFiberScheduler
+  def initialize
+    @readable = {}
+    @writable = {}
+    @waiting = {}
+    @ready = []
+    @blocked = 0
+    @lock = Thread::Mutex.new
+    @urgent = IO.pipe
+  end
+
+  def run
+    while @readable.any? || @writable.any? || @waiting.any? || @blocked > 0 || @ready.any?
+      readable, writable = IO.select(
+        @readable.keys + [@urgent.first], @writable.keys, [], next_timeout)
+
+      selected = {}
+      readable&.each do |io|
+        if io == @urgent.first
+          io.read_nonblock(1024, exception: false)
+        else
+          selected[@readable.delete(io)] = IO::READABLE
+        end
+      end
+      writable&.each do |io|
+        selected[@writable.delete(io)] = IO::WRITABLE
+      end
+      selected.each do |fiber, result|
+        fiber.resume(result) if fiber.alive?
+      end
+
+      time = now
+      @waiting.select { |_, deadline| deadline <= time }.each do |fiber, _|
+        @waiting.delete(fiber)
+        fiber.resume if fiber.alive?
+      end
+
+      ready = @lock.synchronize do
+        @ready.tap { @ready = [] }
+      end
+      ready.each do |fiber|
+        fiber.resume if fiber.alive?
+      end
+    end
+  end
+
+  def io_wait(io, events, timeout)
+    fiber = Fiber.current
+    @readable[io] = fiber if events & IO::READABLE != 0
+    @writable[io] = fiber if events & IO::WRITABLE != 0
+    @waiting[fiber] = now + timeout if timeout
+    result = Fiber.yield
+    result || false
+  ensure
+    @waiting.delete(fiber)
+    @readable.delete(io)
+    @writable.delete(io)
+  end
+
+  def kernel_sleep(duration = nil)
+    @waiting[Fiber.current] = now + duration if duration
+    Fiber.yield
+    true
+  end
+
+  def block(blocker, timeout = nil)
+    if timeout
+      @waiting[Fiber.current] = now + timeout
+      begin
+        Fiber.yield
+      ensure
+        @waiting.delete(Fiber.current)
+      end
+    else
+      @blocked += 1
+      begin
+        Fiber.yield
+      ensure
+        @blocked -= 1
+      end
+    end
+  end
+
+  def unblock(blocker, fiber)
+    @lock.synchronize do
+      @ready << fiber
+    end
+    @urgent.last.write_nonblock('.', exception: false)
+  end
+
+  def close
+    run
+  end
+
+  def fiber(&block)
+    Fiber.new(blocking: false, &block).tap(&:resume)
+  end
+
+  # Runs the block in a scheduled fiber on a new thread with this
+  # scheduler, returning after all fibers have finished.
+  def self.run(&block)
+    Thread.new do
+      Fiber.set_scheduler(new)
+      Fiber.schedule(&block)
+    end.join
+  end
+
+  private
+
+  def now
+    Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  end
+
+  def next_timeout
+    deadline = @waiting.values.min
+    deadline && [deadline - now, 0].max
+  end
+end